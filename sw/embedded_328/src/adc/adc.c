@@ -5,11 +5,16 @@
  *
  * author:      Armin Schlegel, Mr. L.
  * date:        09.10.2014
- * version:     0.3   worky, testing
+ * version:     0.4   worky, testing
  *
  * file history:
  *          09.10.2014  A. Schlegel file created, basic version
  *          14.10.2014  Mr. L.      strutural improvements, nicify layout, add comments
+ *          19.10.2026  agent compile time configuration, direct register access
+ *          19.10.2026  agent averaging depth settable at runtime, exactly 2^n samples
+ *          19.10.2026  agent trace points
+ *          19.10.2026  agent performance counters
+ *          19.10.2026  agent first conversion after a channel change is discarded
  *
  * notes:
  *      bit7  bit6  bit5  bit4  bit3  bit2  bit1  bit0   register
@@ -25,7 +30,10 @@
  * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
  **************************************************************************************************/
 /* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/interrupt.h>
 #include "adc.h"
+#include "../trace/trace.h"
+#include "../perf/perf.h"
 
 
 /* ------------------------------------ DEFINES ------------------------------------------------- */
@@ -36,183 +44,136 @@
 
 /* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
 
-static adc_ConfigType  adcConfig;
-
-static volatile const adc_RegisterAddressType adcRegisterAdresses_as =
-{
-        (uint8*) ADC_ADCL_ADDRESS,
-        (uint8*) ADC_ADCH_ADDRESS,
-        (uint8*) ADC_ADCSRA_ADDRESS,
-        (uint8*) ADC_ADCSRB_ADDRESS,
-        (uint8*) ADC_ADMUX_ADDRESS,
-        (uint8*) ADC_DIDR0_ADDRESS
-};
-
+static adc_AverageType_e adc_average_e = ADC_CFG_AVERAGE;
 
 /* ------------------------------------ PROTOTYPES ---------------------------------------------- */
-static uint16 adc_getResult8bit(void);
-static uint16 adc_getResult10bit(void);
+
+#if (ADC_CFG_CALLBACK == STD_ON)
+extern void ADC_CFG_CALLBACK_FUNC(uint16 adcResult_ui16);
+#endif
 
 
 /* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
 
-void adc_init(const adc_ConfigType *configPtr)
+void adc_init(void)
 {
-    if (configPtr == ADC_CALLBACK_NULL_PTR)
-    {
-        configPtr = (const adc_ConfigType*)adc_getLcfgData();
-    }
-
-    adcConfig.enableState_e         = (adc_EnableStateType_e)         (0x01 & configPtr->enableState_e);
-    adcConfig.interruptState_e      = (adc_InterruptStateType_e)      (0x01 & configPtr->interruptState_e);
-    adcConfig.prescalerControl_e    = (adc_PrescalerType_e)           (0x07 & configPtr->prescalerControl_e);
-    adcConfig.triggerControl_e      = (adc_TriggerType_e)                     configPtr->triggerControl_e;
-    adcConfig.referenceControl_e    = (adc_ReferenceType_e)           (0x03 & configPtr->referenceControl_e);
-    adcConfig.defaultChannel_e      = (adc_ChannelType_e)             (0x07 & configPtr->defaultChannel_e);
-    adcConfig.digitalInputDisable_e = (adc_DigitalInputDisableType_e)         configPtr->digitalInputDisable_e;
-    adcConfig.callbackFunc_pv       = (adc_CallbackType)                      configPtr->callbackFunc_pv;
-    adcConfig.averageControl_e      = (adc_AverageType_e)             (0x07 & configPtr->averageControl_e);
-
     /* enable ADC and set prescaler */
-    *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) = \
-            (adcConfig.enableState_e      << ADC_ADEN) | \
-            (adcConfig.prescalerControl_e << ADC_ADPS0);
+    ADCSRA = ADC_ADCSRA_VALUE;
 
     /* selecting voltage reference, result alignment and ADC channel */
-    *(adcRegisterAdresses_as.adc_MuxRegister_pui8) =  \
-            (adcConfig.referenceControl_e << ADC_REFS0) | \
-            (adcConfig.defaultChannel_e   << ADC_MUX0);
-
-    /* wait for some ADC clock cycles to take the settings */
-    //_delay_ms(1);
+    ADMUX = ADC_ADMUX_VALUE;
+    DIDR0 = ADC_DIDR0_VALUE;
 
 /* ---------------------------------------------------------------------------------------------- */
     /* dummy read out to discard the invalid first conversion value */
-    *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) |= (1 << ADC_ADSC);
-    while (!(*(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) & (1 << ADC_ADIF)));
-    *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) |= (1 << ADC_ADIF);
+    ADCSRA = ADC_ADCSRA_VALUE | (1 << ADC_ADSC);
+    while (!(ADCSRA & (1 << ADC_ADIF)));
+    ADCSRA = ADC_ADCSRA_VALUE | (1 << ADC_ADIF);
 /* ---------------------------------------------------------------------------------------------- */
 
-    /* set the trigger sources if needed */
-    if (adcConfig.triggerControl_e != ADC_TRIGGER_SINGLE_SHOT)
-    {
-        *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterB_pui8)  = (adcConfig.triggerControl_e << ADC_ADTS0);
-        *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) |= (1 << ADC_ADATE);
-    }
-
-    /* configure adc interrupt */
-    *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) |=  (adcConfig.interruptState_e << ADC_ADIE);
+    /* set the trigger source, auto trigger and interrupt */
+    ADCSRB = ADC_ADCSRB_VALUE;
+    ADCSRA = ADC_ADCSRA_RUN;
 }
 
 void adc_disableDigitalInput(const adc_ChannelType_e channels)
 {
     /* disable digital system of given port pin */
-    *(adcRegisterAdresses_as.adc_DigitalInputDisableRegister_pui8) = channels;
-    adcConfig.digitalInputDisable_e = channels;
+    DIDR0 = channels;
 }
 
 void adc_setChannel(const adc_ChannelType_e channel)
 {
-    uint8 autoTriggerFlag = 0;
+    uint8 admux_ui8 = ADC_ADMUX_REFERENCE | (uint8)(0x07 & channel);
 
-    /* disable auto trigger if running */
-    if (*(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) & (1 << ADC_ADATE))
+    if (ADC_CFG_TRIGGER != ADC_TRIGGER_SINGLE_SHOT)
     {
-        autoTriggerFlag = 1;
-        *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) &= ~(1 << ADC_ADATE);
+        /* disable auto trigger while switching */
+        ADCSRA &= ~(1 << ADC_ADATE);
     }
 
     /* wait if a conversion is in progress */
-    while(*(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) & (1 << ADC_ADSC));
+    while (ADCSRA & (1 << ADC_ADSC));
 
-    /* save channel in local config */
-    adcConfig.defaultChannel_e = (adc_ChannelType_e) (0x07 & channel);
-
-    /* clear and set channel in register */
-    *(adcRegisterAdresses_as.adc_MuxRegister_pui8) &= 0xE0;
-    *(adcRegisterAdresses_as.adc_MuxRegister_pui8) |= (adcConfig.defaultChannel_e << ADC_MUX0);
+    /* after a change the sample and hold capacitor still carries the charge of the last
+     * channel. the switch ladder has a source of up to 100k, far above the 10k the datasheet
+     * asks for, so the first conversion on the new channel is thrown away.
+     */
+    if (ADMUX != admux_ui8)
+    {
+        ADMUX = admux_ui8;
+        if ((ADC_CFG_TRIGGER == ADC_TRIGGER_SINGLE_SHOT) && (ADC_CFG_INTERRUPT_STATE == ADC_INTERRUPT_DISABLED))
+        {
+            (void)adc_read10bit();
+        }
+    }
 
-    /* enable auto trigger if previously set */
-    if (autoTriggerFlag != 0) {
-        *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) |= (1 << ADC_ADATE);
+    if (ADC_CFG_TRIGGER != ADC_TRIGGER_SINGLE_SHOT)
+    {
+        ADCSRA |= (1 << ADC_ADATE);
     }
 }
 
-uint8 adc_read8bit(void)
+/* number of samples of the average functions, ADC_CFG_AVERAGE until the first call */
+void adc_setAverage(const adc_AverageType_e average_e)
 {
-    uint16 result_ui16 = 0;
-
-    /* start conversion */
-    *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) |= (1 << ADC_ADSC);
-
-    if(adcConfig.interruptState_e == ADC_INTERRUPT_DISABLED)
-    {
-        /* wait for end of conversion, fetch adc value and clear the flag */
-        while (!(*(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) & (1 << ADC_ADIF)));
-        result_ui16 = adc_getResult8bit();
-        *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) |= (1 << ADC_ADIF);
-    }
-    else
-    {
-        /* NOTE: interrupts and callback function must be configured correctly! */
-    }
+    adc_average_e = (average_e > ADC_AVERAGE_32_SAMPLES) ? ADC_AVERAGE_32_SAMPLES : average_e;
+}
 
-    return (uint8)(result_ui16 >> 2);
+uint8 adc_read8bit(void)
+{
+    return (uint8)(adc_read10bit() >> 2);
 }
 
 uint16 adc_read10bit(void)
 {
     uint16 result_ui16 = 0;
 
+    trace_event(TRACE_ADC_START, (uint16)(ADMUX & 0x07U));
+    perf_count(adcConversions_aui16[ADMUX & 0x07U]);
     /* start conversion */
-    *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) |= (1 << ADC_ADSC);
+    ADCSRA |= (1 << ADC_ADSC);
 
-    if(adcConfig.interruptState_e == ADC_INTERRUPT_DISABLED)
+    if (ADC_CFG_INTERRUPT_STATE == ADC_INTERRUPT_DISABLED)
     {
         /* wait for end of conversion, fetch adc value and clear the flag */
-        while (!(*(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) & (1 << ADC_ADIF)));
-        result_ui16 = adc_getResult10bit();
-        *(adcRegisterAdresses_as.adc_ControlAndStatusRegisterA_pui8) |= (1 << ADC_ADIF);
+        while (!(ADCSRA & (1 << ADC_ADIF)));
+        result_ui16 = ADC;
+        ADCSRA |= (1 << ADC_ADIF);
     }
     else
     {
         /* NOTE: interrupts and callback function must be configured correctly! */
     }
 
+    trace_event(TRACE_ADC_DONE, result_ui16);
     return result_ui16;
 }
 
 uint16 adc_read8bitAverage(void)
 {
    uint16 avResult_ui16 = 0;
-   uint8 averages_ui8;
-
-   averages_ui8 = adcConfig.averageControl_e;
 
-   for(uint8 avCnt_ui8 = 0; avCnt_ui8 <= (1 << averages_ui8); avCnt_ui8++)
+   for(uint8 avCnt_ui8 = 0; avCnt_ui8 < (1 << adc_average_e); avCnt_ui8++)
    {
        avResult_ui16 += adc_read8bit();
    }
 
-   avResult_ui16 = (uint16) (avResult_ui16 >> averages_ui8);
+   avResult_ui16 = (uint16) (avResult_ui16 >> adc_average_e);
 
    return avResult_ui16;
-//   return ((uint8)(avResult_ui16 & 0x00FF));
 }
 
 uint16 adc_read10bitAverage(void)
 {
    uint16 avResult_ui16 = 0;
-   uint8 averages_ui8;
 
-   averages_ui8 = adcConfig.averageControl_e;
-
-   for(uint8 avCnt_ui8 = 0; avCnt_ui8 <= (1 << averages_ui8); avCnt_ui8++)
+   for(uint8 avCnt_ui8 = 0; avCnt_ui8 < (1 << adc_average_e); avCnt_ui8++)
    {
        avResult_ui16 += adc_read10bit();
    }
 
-   avResult_ui16 = (uint16) (avResult_ui16 >> averages_ui8);
+   avResult_ui16 = (uint16) (avResult_ui16 >> adc_average_e);
 
    return avResult_ui16;
 }
@@ -220,32 +181,16 @@ uint16 adc_read10bitAverage(void)
 
 /* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
 
-static uint16 adc_getResult8bit(void)
-{
-    return *(volatile uint16 *)(adcRegisterAdresses_as.adc_DataRegisterLow_pui8);
-}
-
-static uint16 adc_getResult10bit(void)
-{
-    return *(volatile uint16 *)(adcRegisterAdresses_as.adc_DataRegisterLow_pui8);
-}
-
 
 /* ------------------------------------ INTERRUPT SERVICE ROUTINES ------------------------------ */
 
+#if (ADC_CFG_CALLBACK == STD_ON)
 ISR(ADC_vect)
 {
-   uint16 adcResult_ui16 = 0;
-
-   adcResult_ui16 = adc_getResult10bit();
-
-   if(adcConfig.callbackFunc_pv != ADC_CALLBACK_NULL_PTR)
-   {
-      adcConfig.callbackFunc_pv(adcResult_ui16);
-   }
-   else
-   {
-      /* do nothing */
-   }
+   trace_event(TRACE_ISR_ENTRY, TRACE_ISR_ADC);
+   perf_count(isrAdc_ui16);
+   ADC_CFG_CALLBACK_FUNC(ADC);
+   trace_event(TRACE_ISR_EXIT, TRACE_ISR_ADC);
 }
+#endif
 /* ************************************ E O F *************************************************** */
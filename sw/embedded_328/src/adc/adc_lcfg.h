@@ -1,18 +1,21 @@
 /* *************************************************************************************************
  * file:        adc_lcfg.h
  *
- *          The adc module linktime configuration header.
+ *          The adc module configuration header.
  *
  * author:      Armin Schlegel, Mr. L.
  * date:        09.10.2014
- * version:     0.3   worky, testing
+ * version:     0.4   worky, testing
  *
  * file history:
  *          09.10.2014  A. Schlegel file created, basic version
  *          14.10.2014  Mr. L.      nicify layout, add comments
+ *          19.10.2026  agent configuration moved from adc_lcfg.c to compile time defines
  *
  * notes:
- *          - none -
+ *          the configuration has to be filled with the types defined in adc.h. the register
+ *          values are folded by the compiler (see adc_cfg.h), so adc_init() only stores
+ *          constants. no validity check is applied, one has to explicitly know his target.
  *
  * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
  **************************************************************************************************/
@@ -24,14 +27,26 @@
 
 /* ------------------------------------ DEFINES ------------------------------------------------- */
 
+#define ADC_CFG_ENABLE_STATE            ADC_MODULE_ENABLED
+#define ADC_CFG_INTERRUPT_STATE         ADC_INTERRUPT_DISABLED
+#define ADC_CFG_PRESCALER               ADC_CLOCK_PRESCALER_64
+#define ADC_CFG_TRIGGER                 ADC_TRIGGER_SINGLE_SHOT
+#define ADC_CFG_REFERENCE               ADC_REFERENCE_AVCC
+#define ADC_CFG_DEFAULT_CHANNEL         ADC_CHANNEL_7
+#define ADC_CFG_DIGITAL_INPUT_DISABLE   ADC_DIGITAL_INPUT_DISABLE_NONE
+#define ADC_CFG_AVERAGE                 ADC_AVERAGE_4_SAMPLES
+
+/* STD_ON calls ADC_CFG_CALLBACK_FUNC(uint16 result) from the adc interrupt */
+#define ADC_CFG_CALLBACK                STD_OFF
+#define ADC_CFG_CALLBACK_FUNC           adc_Callback
+
+
 /* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
 
 /* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
 
 /* ------------------------------------ PROTOTYPES ---------------------------------------------- */
 
-const void *adc_getLcfgData(void);
-
 
 /* ************************************ E O F *************************************************** */
 #endif /* _ADC_LCFG_H_ */
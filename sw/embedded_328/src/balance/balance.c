@@ -0,0 +1,127 @@
+/* *************************************************************************************************
+ * file:        balance.c
+ *
+ *          The balance connector module.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the taps below the top of the pack are converted back to back, the results are
+ *          scaled in fixed point. the top tap is the pack voltage the caller already has.
+ *          adc_setChannel() throws away the first conversion after every change, so a 5S
+ *          scan costs 8 conversions of 52us at 16MHz and prescaler 64, about 0.42ms. that
+ *          comes on top of the pack reading and is not inside the time of the old two
+ *          channel loop, only the switch reading that the cell detection saves pays for a
+ *          part of it.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include "balance.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define BALANCE_ADC_FULL_SCALE  (1023UL)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static const balance_ConfigType *balanceConfig;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void balance_init(void)
+{
+    uint8 tap_ui8;
+    uint8 digitalInputMask_ui8 = 0;
+
+    balanceConfig = (const balance_ConfigType*)balance_getLcfgData();
+
+    /* the taps are analog only, DIDR0 covers channel 0 to 5 */
+    for (tap_ui8 = 0; tap_ui8 < BALANCE_NUM_OF_TAPS; tap_ui8++)
+    {
+        if (balanceConfig->taps_as[tap_ui8].channel_e <= ADC_CHANNEL_5)
+        {
+            digitalInputMask_ui8 |= (uint8)(1 << balanceConfig->taps_as[tap_ui8].channel_e);
+        }
+    }
+    adc_disableDigitalInput((adc_ChannelType_e)digitalInputMask_ui8);
+}
+
+boolean balance_scan(uint8 cells_ui8, uint16 packMilliVolt_ui16, balance_ResultType *result_ps)
+{
+    uint16 tapMilliVolt_aui16[BALANCE_SCAN_MAX_CELLS];
+    uint16 lowerTap_ui16 = 0;
+    uint16 cell_ui16;
+    uint8 tap_ui8;
+
+    if ((cells_ui8 == 0) || (cells_ui8 > BALANCE_SCAN_MAX_CELLS))
+    {
+        return FALSE;
+    }
+
+    /* convert all taps in one burst so they are as close in time as possible */
+    for (tap_ui8 = 0; tap_ui8 < (cells_ui8 - 1U); tap_ui8++)
+    {
+        adc_setChannel(balanceConfig->taps_as[tap_ui8].channel_e);
+        tapMilliVolt_aui16[tap_ui8] = adc_read10bit();
+    }
+
+    for (tap_ui8 = 0; tap_ui8 < (cells_ui8 - 1U); tap_ui8++)
+    {
+        tapMilliVolt_aui16[tap_ui8] = (uint16)(((uint32)tapMilliVolt_aui16[tap_ui8] *
+                                      balanceConfig->taps_as[tap_ui8].fullScaleMilliVolt_ui16) / BALANCE_ADC_FULL_SCALE);
+    }
+    tapMilliVolt_aui16[cells_ui8 - 1U] = packMilliVolt_ui16;
+
+    /* a 1S pack has no tap below the top, the lead can not be told from the pack plug */
+    if ((cells_ui8 > 1U) && (tapMilliVolt_aui16[0] < BALANCE_LEAD_DETECT_MILLIVOLT))
+    {
+        return FALSE;
+    }
+
+    result_ps->numberOfCells_ui8 = cells_ui8;
+    result_ps->minCellMilliVolt_ui16 = 0xFFFF;
+    result_ps->maxCellMilliVolt_ui16 = 0;
+    result_ps->minCell_ui8 = 0;
+
+    for (tap_ui8 = 0; tap_ui8 < cells_ui8; tap_ui8++)
+    {
+        /* a tap below its lower neighbour is noise around an empty cell */
+        cell_ui16 = (tapMilliVolt_aui16[tap_ui8] > lowerTap_ui16) ? (tapMilliVolt_aui16[tap_ui8] - lowerTap_ui16) : 0;
+        lowerTap_ui16 = tapMilliVolt_aui16[tap_ui8];
+
+        result_ps->cellMilliVolt_aui16[tap_ui8] = cell_ui16;
+        if (cell_ui16 < result_ps->minCellMilliVolt_ui16)
+        {
+            result_ps->minCellMilliVolt_ui16 = cell_ui16;
+            result_ps->minCell_ui8 = tap_ui8;
+        }
+        if (cell_ui16 > result_ps->maxCellMilliVolt_ui16)
+        {
+            result_ps->maxCellMilliVolt_ui16 = cell_ui16;
+        }
+    }
+
+    result_ps->imbalanceMilliVolt_ui16 = result_ps->maxCellMilliVolt_ui16 - result_ps->minCellMilliVolt_ui16;
+
+    return TRUE;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,77 @@
+/* *************************************************************************************************
+ * file:        balance.h
+ *
+ *          The balance connector module header.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          each tap of the balance lead is divided down to one adc channel. tap n carries
+ *          the sum of cells 1..n, the cell voltages are the differences of adjacent taps.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _BALANCE_H_
+#define _BALANCE_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "std_types.h"
+#include "balance_lcfg.h"
+#include "../adc/adc.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define BALANCE_MAX_CELLS               (6U)
+
+/* taps below the top of the pack, the top tap is the pack voltage itself */
+#define BALANCE_NUM_OF_TAPS             (4U)
+
+/* the largest pack the balance lead can split into cells */
+#define BALANCE_SCAN_MAX_CELLS          (BALANCE_NUM_OF_TAPS + 1U)
+
+/* below this first tap voltage no balance lead is considered connected */
+#define BALANCE_LEAD_DETECT_MILLIVOLT   (1000U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* one tap of the balance lead */
+typedef struct
+{
+    adc_ChannelType_e   channel_e;
+    uint16              fullScaleMilliVolt_ui16;    // tap voltage at adc full scale
+}balance_TapConfigType;
+
+typedef struct
+{
+    balance_TapConfigType   taps_as[BALANCE_NUM_OF_TAPS];
+}balance_ConfigType;
+
+typedef struct
+{
+    uint16  cellMilliVolt_aui16[BALANCE_MAX_CELLS];
+    uint16  minCellMilliVolt_ui16;
+    uint16  maxCellMilliVolt_ui16;
+    uint16  imbalanceMilliVolt_ui16;
+    uint8   minCell_ui8;                            // index of the weakest cell, 0 = cell 1
+    uint8   numberOfCells_ui8;
+}balance_ResultType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void balance_init(void);
+boolean balance_scan(uint8 cells_ui8, uint16 packMilliVolt_ui16, balance_ResultType *result_ps);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _BALANCE_H_ */
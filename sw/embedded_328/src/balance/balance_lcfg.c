@@ -0,0 +1,62 @@
+/* *************************************************************************************************
+ * file:        balance_lcfg.c
+ *
+ *          The balance connector module linktime configuration.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the full scale values have to match the divider of each tap on the balance
+ *          adapter. the defaults assume 5V per cell at adc full scale.
+ *          PC4/PC5 (ADC4/ADC5) are SDA/SCL of the twi and balance_init() would switch off
+ *          their digital input, so the taps use ADC2/ADC3 and the analog only ADC6/ADC7. the
+ *          top of the pack comes from the pack divider on ADC1, which makes 5S the largest
+ *          pack the lead can split.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "balance.h"
+#include "balance_lcfg.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static const balance_ConfigType balance_initialConfiguration_s =
+{
+        {
+            /* channel, full scale */
+            {ADC_CHANNEL_2,  5000},         // tap 1: cell 1
+            {ADC_CHANNEL_3, 10000},         // tap 2: cells 1..2
+            {ADC_CHANNEL_6, 15000},         // tap 3: cells 1..3
+            {ADC_CHANNEL_7, 20000}          // tap 4: cells 1..4
+        }
+};
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+const void *balance_getLcfgData(void)
+{
+   return ((const void*) &balance_initialConfiguration_s);
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* ************************************ E O F *************************************************** */
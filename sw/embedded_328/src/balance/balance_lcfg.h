@@ -0,0 +1,36 @@
+/* *************************************************************************************************
+ * file:        balance_lcfg.h
+ *
+ *          The balance connector module linktime configuration header.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _BALANCE_LCFG_H_
+#define _BALANCE_LCFG_H_
+/* ============================================================================================== */
+
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+const void *balance_getLcfgData(void);
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _BALANCE_LCFG_H_ */
@@ -0,0 +1,280 @@
+/* *************************************************************************************************
+ * file:        command.c
+ *
+ *          The command module, live reconfiguration over the uart.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent trace mask
+ *
+ * notes:
+ *          the line is split in the receive buffer of the uart, blanks are overwritten with
+ *          zeros and the name is compared where it is. only the numeric arguments end up on
+ *          the stack. the table lives in flash.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <stddef.h>
+#include <avr/pgmspace.h>
+#include "command.h"
+#include "../uart/uart.h"
+#include "../soc/soc.h"
+#include "../settings/settings.h"
+#include "../dump/dump.h"
+#include "../format/format.h"
+#include "../trace/trace.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define COMMAND_NUM_OF_ENTRIES      (sizeof(command_table_as) / sizeof(command_table_as[0]))
+
+/* number of arguments if one is not a number, matches no entry */
+#define COMMAND_BAD_ARGS            (0xFFU)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static Std_ReturnType command_get(const uint16 *args_pui16);
+static Std_ReturnType command_thresholds(const uint16 *args_pui16);
+static Std_ReturnType command_cycle(const uint16 *args_pui16);
+static Std_ReturnType command_filter(const uint16 *args_pui16);
+static Std_ReturnType command_display(const uint16 *args_pui16);
+static Std_ReturnType command_chemistry(const uint16 *args_pui16);
+static Std_ReturnType command_calibrate(const uint16 *args_pui16);
+static Std_ReturnType command_reset(const uint16 *args_pui16);
+static Std_ReturnType command_dump(const uint16 *args_pui16);
+static Std_ReturnType command_trace(const uint16 *args_pui16);
+
+static char *command_token(char *line_pc);
+static Std_ReturnType command_number(const char *token_pc, uint16 *value_pui16);
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static const command_EntryType command_table_as[] PROGMEM =
+{
+    { "get",     0U,                         command_get        },
+    { "thr",     SETTINGS_NUM_OF_THRESHOLDS, command_thresholds },
+    { "cycle",   1U,                         command_cycle      },
+    { "filter",  1U,                         command_filter     },
+    { "display", 1U,                         command_display    },
+    { "chem",    1U,                         command_chemistry  },
+    { "cal",     1U,                         command_calibrate  },
+    { "reset",   0U,                         command_reset      },
+    { "dump",    1U,                         command_dump       },
+    { "trace",   1U,                         command_trace      },
+};
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+/* executes a received line, call it from the main loop */
+void command_poll(void)
+{
+    command_EntryType entry_s;
+    uint16 args_aui16[COMMAND_MAX_ARGS];
+    command_HandlerType handler_pf = NULL;
+    Std_ReturnType result_e = E_NOT_OK;
+    char *line_pc = uart_getLine();
+    char *token_pc;
+    uint8 numberOfArgs_ui8 = 0;
+    uint8 index_ui8;
+
+    if (line_pc == NULL)
+    {
+        return;
+    }
+
+    /* the name stays the first token, the arguments follow */
+    token_pc = command_token(line_pc);
+    while (*token_pc != '\0')
+    {
+        if ((numberOfArgs_ui8 >= COMMAND_MAX_ARGS) || (command_number(token_pc, &args_aui16[numberOfArgs_ui8]) != E_OK))
+        {
+            numberOfArgs_ui8 = COMMAND_BAD_ARGS;
+            break;
+        }
+        numberOfArgs_ui8++;
+        token_pc = command_token(token_pc);
+    }
+
+    for (index_ui8 = 0; index_ui8 < COMMAND_NUM_OF_ENTRIES; index_ui8++)
+    {
+        if (strcmp_P(line_pc, command_table_as[index_ui8].name_ac) == 0)
+        {
+            memcpy_P(&entry_s, &command_table_as[index_ui8], sizeof(entry_s));
+            if (numberOfArgs_ui8 == entry_s.numberOfArgs_ui8)
+            {
+                handler_pf = entry_s.handler_pf;
+                trace_event(TRACE_COMMAND, index_ui8);
+            }
+            break;
+        }
+    }
+
+    /* everything needed is parsed, the next line may come in while the command runs */
+    uart_releaseLine();
+    if (handler_pf != NULL)
+    {
+        result_e = handler_pf(args_aui16);
+    }
+    format_string_P((result_e == E_OK) ? PSTR("OK\n\r") : PSTR("ERR\n\r"));
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* terminates the token that starts at line_pc and returns the start of the next one, or
+ * the terminating zero of the line
+ */
+static char *command_token(char *line_pc)
+{
+    while ((*line_pc != ' ') && (*line_pc != '\0'))
+    {
+        line_pc++;
+    }
+    while (*line_pc == ' ')
+    {
+        *line_pc++ = '\0';
+    }
+    return line_pc;
+}
+
+static Std_ReturnType command_number(const char *token_pc, uint16 *value_pui16)
+{
+    uint32 value_ui32 = 0;
+
+    do
+    {
+        if ((*token_pc < '0') || (*token_pc > '9'))
+        {
+            return E_NOT_OK;
+        }
+        value_ui32 = value_ui32 * 10U + (uint8)(*token_pc - '0');
+        if (value_ui32 > 0xFFFFU)
+        {
+            return E_NOT_OK;
+        }
+        token_pc++;
+    } while (*token_pc != '\0');
+
+    *value_pui16 = (uint16)value_ui32;
+    return E_OK;
+}
+
+static Std_ReturnType command_get(const uint16 *args_pui16)
+{
+    const settings_DataType *settings_ps = settings_get();
+    uint8 level_ui8;
+
+    (void)args_pui16;
+    format_string_P(PSTR("thr"));
+    for (level_ui8 = 0; level_ui8 < SETTINGS_NUM_OF_THRESHOLDS; level_ui8++)
+    {
+        uart_putc(' ');
+        format_unsigned(settings_ps->thresholdPercent_aui8[level_ui8]);
+    }
+    format_string_P(PSTR(" cycle "));
+    format_unsigned(settings_ps->cycleMilliSeconds_ui16);
+    format_string_P(PSTR(" filter "));
+    format_unsigned(settings_ps->filterDepth_ui8);
+    format_string_P(PSTR(" display "));
+    format_unsigned(settings_ps->displayMode_ui8);
+    format_string_P(PSTR(" chem "));
+    format_unsigned((uint8)soc_getChemistry());
+    format_string_P(PSTR(" gain "));
+    format_unsigned(settings_ps->ubatGain_ui16);
+    format_string_P(PSTR("\n\r"));
+    return E_OK;
+}
+
+static Std_ReturnType command_thresholds(const uint16 *args_pui16)
+{
+    uint8 percent_aui8[SETTINGS_NUM_OF_THRESHOLDS];
+    uint8 level_ui8;
+
+    for (level_ui8 = 0; level_ui8 < SETTINGS_NUM_OF_THRESHOLDS; level_ui8++)
+    {
+        if (args_pui16[level_ui8] > 100U)
+        {
+            return E_NOT_OK;
+        }
+        percent_aui8[level_ui8] = (uint8)args_pui16[level_ui8];
+    }
+    return settings_setThresholds(percent_aui8);
+}
+
+static Std_ReturnType command_cycle(const uint16 *args_pui16)
+{
+    return settings_setCycle(args_pui16[0]);
+}
+
+static Std_ReturnType command_filter(const uint16 *args_pui16)
+{
+    return (args_pui16[0] > 0xFFU) ? E_NOT_OK : settings_setFilterDepth((uint8)args_pui16[0]);
+}
+
+static Std_ReturnType command_display(const uint16 *args_pui16)
+{
+    return (args_pui16[0] > 0xFFU) ? E_NOT_OK : settings_setDisplayMode((uint8)args_pui16[0]);
+}
+
+/* the thresholds in adc digits depend on the chemistry too */
+static Std_ReturnType command_chemistry(const uint16 *args_pui16)
+{
+    if (args_pui16[0] >= (uint16)SOC_CHEMISTRY_COUNT)
+    {
+        return E_NOT_OK;
+    }
+    soc_setChemistry((soc_ChemistryType)args_pui16[0]);
+    settings_changed();
+    return E_OK;
+}
+
+static Std_ReturnType command_calibrate(const uint16 *args_pui16)
+{
+    if (args_pui16[0] == 0U)
+    {
+        return E_NOT_OK;
+    }
+    settings_requestCalibration(args_pui16[0]);
+    return E_OK;
+}
+
+static Std_ReturnType command_reset(const uint16 *args_pui16)
+{
+    (void)args_pui16;
+    settings_reset();
+    return E_OK;
+}
+
+static Std_ReturnType command_dump(const uint16 *args_pui16)
+{
+    if (args_pui16[0] >= (uint16)UART_BAUD_COUNT)
+    {
+        return E_NOT_OK;
+    }
+    return dump_run((uart_baudType)args_pui16[0]);
+}
+
+static Std_ReturnType command_trace(const uint16 *args_pui16)
+{
+    if (args_pui16[0] > TRACE_GROUP_ALL)
+    {
+        return E_NOT_OK;
+    }
+    (void)trace_setMask((uint8)args_pui16[0]);
+    return E_OK;
+}
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,70 @@
+/* *************************************************************************************************
+ * file:        command.h
+ *
+ *          The command module header, live reconfiguration over the uart.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent trace mask
+ *
+ * notes:
+ *          a command is one line at UART_BAUD: the name and up to COMMAND_MAX_ARGS decimal
+ *          arguments separated by blanks. the answer is "OK", "ERR" or the requested
+ *          values, each ended by "\n\r".
+ *
+ *          get                     all settings in the order of the commands below
+ *          thr <p80> <p60> <p40> <p20>
+ *                                  soc thresholds of the led levels in %, falling
+ *          cycle <ms>              main loop cycle, SETTINGS_CYCLE_MIN_MS..SETTINGS_CYCLE_MAX_MS
+ *          filter <n>              2^n adc samples are averaged, 0..SETTINGS_FILTER_DEPTH_MAX
+ *          display <n>             0: bar, 1: dot, 2: strobe
+ *          chem <n>                soc_ChemistryType
+ *          cal <mV>                true pack voltage, the next measurement is calibrated
+ *          reset                   default settings, the calibration is lost
+ *          dump <n>                dump at uart_baudType n, see dump/dump.h
+ *          trace <mask>            recorded TRACE_GROUP_* bits, 0 stops, see trace/trace.h
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _COMMAND_H_
+#define _COMMAND_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define COMMAND_MAX_ARGS            (4U)
+
+/* longest command name including the terminating zero */
+#define COMMAND_NAME_SIZE           (8U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* arguments are parsed before the handler is called, their number is checked by the table */
+typedef Std_ReturnType (*command_HandlerType)(const uint16 *args_pui16);
+
+typedef struct
+{
+    char                name_ac[COMMAND_NAME_SIZE];
+    uint8               numberOfArgs_ui8;
+    command_HandlerType handler_pf;
+}command_EntryType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void command_poll(void);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _COMMAND_H_ */
@@ -0,0 +1,137 @@
+/* *************************************************************************************************
+ * file:        dump.c
+ *
+ *          The dump module, history and statistics over the uart at a high baudrate.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent requested by the "dump" command, sync as a line
+ *          19.10.2026  agent trace frame
+ *
+ * notes:
+ *          the bytes go out through the transmit ring of the uart, the interrupt keeps the
+ *          line busy while the next frame is assembled. at 1MBaud the whole history of the
+ *          328 takes about 6ms instead of 0.6s at 9600 baud.
+ *          the trace is stopped for the whole dump, the ring shows what happened before it.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/pgmspace.h>
+#include <string.h>
+#include <util/crc16.h>
+#include "dump.h"
+#include "../timer/timer.h"
+#include "../format/format.h"
+#include "../stats/stats.h"
+#include "../history/history.h"
+#include "../trace/trace.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#if ((HISTORY_DEPTH * 3U + 3U) > 255U)
+#error "dump: a history level does not fit into one frame"
+#endif
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static void dump_frame(uint8 type_ui8, const uint8 *prefix_pui8, uint8 prefixLength_ui8, const uint8 *data_pui8, uint8 length_ui8);
+static uint8 dump_crc(uint8 crc_ui8, const uint8 *data_pui8, uint8 length_ui8);
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+/* runs from the command handler, the line holding the command is released here */
+Std_ReturnType dump_run(uart_baudType baud_e)
+{
+    const history_DataType *history_ps = history_get();
+    timer_TickType start_ui16;
+    char *line_pc;
+    uint8 level_ui8;
+    uint8 frames_ui8 = 0;
+    uint8 traceMask_ui8 = trace_setMask(0);
+
+    format_string_P(PSTR("DUMP "));
+    format_unsigned((uint8)baud_e);
+    format_string_P(PSTR("\n\r"));
+    uart_setBaud(baud_e);
+
+    /* drop what came in at the old baudrate, then the host has to prove that it follows */
+    uart_releaseLine();
+    start_ui16 = timer_getTicks();
+    while (((line_pc = uart_getLine()) == NULL) || (strcmp(line_pc, DUMP_SYNC) != 0))
+    {
+        if (line_pc != NULL)
+        {
+            /* garbage from the baudrate switch */
+            uart_releaseLine();
+        }
+        if (timer_elapsed(start_ui16) > DUMP_SYNC_TIMEOUT_MS)
+        {
+            uart_setBaud(UART_BAUD_NORMAL);
+            (void)trace_setMask(traceMask_ui8);
+            return E_NOT_OK;
+        }
+    }
+    uart_releaseLine();
+
+    dump_frame(DUMP_FRAME_STATS, NULL, 0, (const uint8 *)stats_get(), sizeof(stats_RecordType));
+    frames_ui8++;
+    for (level_ui8 = 0; level_ui8 < HISTORY_NUM_OF_LEVELS; level_ui8++)
+    {
+        dump_frame(DUMP_FRAME_HISTORY, &level_ui8, 1, (const uint8 *)&history_ps->levels_as[level_ui8], sizeof(history_LevelType));
+        frames_ui8++;
+    }
+    /* TRACE_SIZE is checked against the frame length in trace.c */
+    dump_frame(DUMP_FRAME_TRACE, NULL, 0, (const uint8 *)trace_get(), sizeof(trace_RingType));
+    frames_ui8++;
+    dump_frame(DUMP_FRAME_END, NULL, 0, &frames_ui8, 1);
+
+    uart_setBaud(UART_BAUD_NORMAL);
+    (void)trace_setMask(traceMask_ui8);
+    return E_OK;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+static void dump_frame(uint8 type_ui8, const uint8 *prefix_pui8, uint8 prefixLength_ui8, const uint8 *data_pui8, uint8 length_ui8)
+{
+    uint8 header_aui8[3];
+    uint8 crc_ui8;
+
+    header_aui8[0] = DUMP_FRAME_START;
+    header_aui8[1] = type_ui8;
+    header_aui8[2] = (uint8)(prefixLength_ui8 + length_ui8);
+
+    crc_ui8 = dump_crc(0, &header_aui8[1], 2);
+    crc_ui8 = dump_crc(crc_ui8, prefix_pui8, prefixLength_ui8);
+    crc_ui8 = dump_crc(crc_ui8, data_pui8, length_ui8);
+
+    uart_write(header_aui8, sizeof(header_aui8));
+    uart_write(prefix_pui8, prefixLength_ui8);
+    uart_write(data_pui8, length_ui8);
+    uart_putc(crc_ui8);
+}
+
+static uint8 dump_crc(uint8 crc_ui8, const uint8 *data_pui8, uint8 length_ui8)
+{
+    while (length_ui8--)
+    {
+        crc_ui8 = _crc8_ccitt_update(crc_ui8, *data_pui8++);
+    }
+    return crc_ui8;
+}
+
+/* ************************************ E O F *************************************************** */
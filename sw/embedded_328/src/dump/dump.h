@@ -0,0 +1,63 @@
+/* *************************************************************************************************
+ * file:        dump.h
+ *
+ *          The dump module header, history and statistics over the uart at a high baudrate.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent requested by the "dump" command, sync as a line
+ *          19.10.2026  agent trace frame
+ *
+ * notes:
+ *          protocol, sw/tools/dump.py is the host side:
+ *          1. host sends the line "dump <n>", n is the baudrate as uart_baudType
+ *          2. device answers "DUMP <n>\n\r" at UART_BAUD and switches the baudrate
+ *          3. host switches too and sends the line "S" within DUMP_SYNC_TIMEOUT_MS,
+ *             else the device falls back to UART_BAUD
+ *          4. device sends the frames and switches back to UART_BAUD
+ *
+ *          frame: 0xA5, type, length, payload[length], crc8 ccitt over type, length, payload
+ *          STATS payload:   stats_RecordType
+ *          HISTORY payload: level, history_LevelType
+ *          TRACE payload:   trace_RingType
+ *          END payload:     number of frames before
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _DUMP_H_
+#define _DUMP_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+#include "../uart/uart.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define DUMP_SYNC                   ("S")
+#define DUMP_SYNC_TIMEOUT_MS        (1000U)
+
+#define DUMP_FRAME_START            (0xA5U)
+#define DUMP_FRAME_STATS            (0x01U)
+#define DUMP_FRAME_HISTORY          (0x02U)
+#define DUMP_FRAME_TRACE            (0x03U)
+#define DUMP_FRAME_END              (0xFFU)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+Std_ReturnType dump_run(uart_baudType baud_e);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _DUMP_H_ */
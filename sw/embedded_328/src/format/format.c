@@ -0,0 +1,128 @@
+/* *************************************************************************************************
+ * file:        format.c
+ *
+ *          The format module, numbers as text straight into the uart transmit ring.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/pgmspace.h>
+#include "format.h"
+#include "../uart/uart.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+/* indexed by the exponent */
+static const uint32 format_powersOfTen_aui32[FORMAT_MAX_DIGITS] PROGMEM =
+{
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+/* sends a string that lives in flash, e.g. format_string_P(PSTR("text")) */
+void format_string_P(const char *string_pc)
+{
+    char character_c;
+
+    while ((character_c = (char)pgm_read_byte(string_pc++)) != '\0')
+    {
+        uart_putc((uint8)character_c);
+    }
+}
+
+void format_unsigned(uint32 value_ui32)
+{
+    format_decimal(value_ui32, 0U);
+}
+
+void format_signed(sint32 value_si32)
+{
+    if (value_si32 < 0)
+    {
+        uart_putc('-');
+        format_decimal((uint32)0UL - (uint32)value_si32, 0U);
+    }
+    else
+    {
+        format_decimal((uint32)value_si32, 0U);
+    }
+}
+
+/* sends value / 10^decimals with a point, format_decimal(5, 2) is "0.05" */
+void format_decimal(uint32 value_ui32, uint8 decimals_ui8)
+{
+    uint32 power_ui32;
+    uint8 exponent_ui8 = FORMAT_MAX_DIGITS;
+    boolean leading_b = TRUE;
+    uint8 digit_ui8;
+
+    while (exponent_ui8-- > 0U)
+    {
+        power_ui32 = pgm_read_dword(&format_powersOfTen_aui32[exponent_ui8]);
+        digit_ui8 = '0';
+        while (value_ui32 >= power_ui32)
+        {
+            value_ui32 -= power_ui32;
+            digit_ui8++;
+        }
+
+        /* leading zeros are skipped, but not the one in front of the point */
+        if ((digit_ui8 != '0') || (exponent_ui8 <= decimals_ui8))
+        {
+            leading_b = FALSE;
+        }
+        if (leading_b == FALSE)
+        {
+            uart_putc(digit_ui8);
+            if ((exponent_ui8 == decimals_ui8) && (exponent_ui8 != 0U))
+            {
+                uart_putc('.');
+            }
+        }
+    }
+}
+
+/* sends a voltage as V.VV, rounded to 10mV */
+void format_milliVolt(uint16 milliVolt_ui16)
+{
+    format_decimal(((uint32)milliVolt_ui16 + 5UL) / 10UL, 2U);
+}
+
+/* sends the lowest digits_ui8 nibbles as upper case hex, without prefix */
+void format_hex(uint32 value_ui32, uint8 digits_ui8)
+{
+    uint8 nibble_ui8;
+
+    while (digits_ui8-- > 0U)
+    {
+        nibble_ui8 = (uint8)((value_ui32 >> (digits_ui8 * 4U)) & 0x0FU);
+        uart_putc((nibble_ui8 < 10U) ? (uint8)('0' + nibble_ui8) : (uint8)('A' - 10 + nibble_ui8));
+    }
+}
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+
+/* ************************************ E O F *************************************************** */
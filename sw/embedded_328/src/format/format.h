@@ -0,0 +1,56 @@
+/* *************************************************************************************************
+ * file:        format.h
+ *
+ *          The format module header, numbers as text straight into the uart transmit ring.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent unmeasured cost comparison removed
+ *
+ * notes:
+ *          replaces sprintf() and the float vfprintf of avr-libc (-lprintf_flt, -lm). there
+ *          is no format string to interpret and no buffer on the stack, every character
+ *          goes to uart_putc(). strings stay in flash, see format_string_P().
+ *
+ *          a decimal digit is found by subtracting its power of ten at most 9 times, there
+ *          is no division except the rounding of format_milliVolt(). neither the flash nor
+ *          the cycles have been measured against sprintf() and vfprintf yet, see
+ *          doc/open_items.md. the "make" of this tree prints the size (avr-size).
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _FORMAT_H_
+#define _FORMAT_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* digits of the largest uint32 */
+#define FORMAT_MAX_DIGITS           (10U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void format_string_P(const char *string_pc);
+void format_unsigned(uint32 value_ui32);
+void format_signed(sint32 value_si32);
+void format_decimal(uint32 value_ui32, uint8 decimals_ui8);
+void format_milliVolt(uint16 milliVolt_ui16);
+void format_hex(uint32 value_ui32, uint8 digits_ui8);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _FORMAT_H_ */
@@ -0,0 +1,54 @@
+/* *************************************************************************************************
+ * file:        hal.h
+ *
+ *          The hardware abstraction header, what the indicator needs from the board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          hal.c implements it with the gpio and adc drivers, the pins are in hal_cfg.h.
+ *          sw/host/hal_host.c implements it on simulated registers for the host build.
+ *          this header must not include anything that touches avr/io.h.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HAL_H_
+#define _HAL_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define HAL_NUM_OF_LEDS             (5U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef enum
+{
+    HAL_CHANNEL_SWITCH = 0U,        // cell count switch ladder
+    HAL_CHANNEL_UBAT,               // pack voltage divider
+    HAL_CHANNEL_COUNT
+}hal_ChannelType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void hal_init(void);
+uint16 hal_readChannel(hal_ChannelType channel_e);
+void hal_writeLeds(uint8 mask_ui8);
+void hal_delayMs(uint16 milliSeconds_ui16);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _HAL_H_ */
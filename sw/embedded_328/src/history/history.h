@@ -0,0 +1,76 @@
+/* *************************************************************************************************
+ * file:        history.h
+ *
+ *          The history module header, min/avg/max of the cell voltage in three resolutions.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          a slot of level n+1 consolidates HISTORY_LEVELn+1_SLOTS slots of level n, like a
+ *          round robin database. a voltage is stored in one byte, 10mV steps from 2.5V on.
+ *          history_get() returns the whole history as one block for a dump, the rings are
+ *          oldest first from head - count on.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HISTORY_H_
+#define _HISTORY_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+#include "history_cfg.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define HISTORY_NUM_OF_LEVELS       (3U)
+
+#define HISTORY_OFFSET_MV           (2500U)
+#define HISTORY_STEP_MV             (10U)
+#define history_decode(x)           ((uint16)(HISTORY_OFFSET_MV + (uint16)(x) * HISTORY_STEP_MV))
+
+#if (HISTORY_DEPTH > 255U) || (HISTORY_LEVEL0_CYCLES == 0U)
+#error "history: check history_cfg.h"
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    uint8   min_ui8;
+    uint8   avg_ui8;
+    uint8   max_ui8;
+}history_SlotType;
+
+typedef struct
+{
+    history_SlotType    slots_as[HISTORY_DEPTH];
+    uint8               head_ui8;                   // next slot to write
+    uint8               count_ui8;                  // valid slots
+}history_LevelType;
+
+typedef struct
+{
+    history_LevelType   levels_as[HISTORY_NUM_OF_LEVELS];
+}history_DataType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void history_init(void);
+void history_add(uint16 cellMilliVolt_ui16);
+void history_save(void);
+const history_DataType *history_get(void);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _HISTORY_H_ */
@@ -0,0 +1,36 @@
+/* *************************************************************************************************
+ * file:        indicator_cfg.h
+ *
+ *          The indicator module configuration of the ATmega328 board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          thresholds, display mode and cycle are changed over the uart, see settings.h
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _INDICATOR_CFG_H_
+#define _INDICATOR_CFG_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define CELL_DETECTION_AUTO         STD_ON   /* STD_OFF: cell count from the switch only */
+
+/* STD_ON: the tunable values are read from settings.h */
+#define INDICATOR_SETTINGS          STD_ON
+
+/* STD_ON: an invalid reading blinks the top segment, STD_OFF: every other segment is lit */
+#define INDICATOR_INVALID_BLINK     STD_ON
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _INDICATOR_CFG_H_ */
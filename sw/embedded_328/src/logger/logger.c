@@ -0,0 +1,290 @@
+/* *************************************************************************************************
+ * file:        logger.c
+ *
+ *          The data logger module, samples into an external I2C eeprom.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          records are collected in one of two RAM pages. a full page is handed to the twi
+ *          queue as one page write while the other page takes the next records, so the
+ *          measurement loop never waits for the bus or the write cycle. an eeprom that is
+ *          still busy does not acknowledge, the page is tried again on the next call of
+ *          logger_task(). the ring position only moves on when a page was taken.
+ *
+ *          boot: the sequence of page p is seq[0] + p for all pages written in the current
+ *          round of the ring and something else behind it, so a binary search finds the
+ *          newest page with log2(LOGGER_NUM_OF_PAGES) header reads.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <util/atomic.h>
+#include "logger.h"
+#include "../twi/twi.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define LOGGER_ERASED_SEQUENCE      (0xFFFFU)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    uint16              sequence_ui16;
+    uint8               count_ui8;
+    uint8               checksum_ui8;
+    logger_RecordType   records_as[LOGGER_RECORDS_PER_PAGE];
+}logger_PageType;
+
+/* eeprom address in front of the page, sent in the same transaction */
+typedef struct
+{
+    uint8               address_aui8[EEPROM_ADDR_2_BYTES];
+    logger_PageType     page_s;
+}logger_BufferType;
+
+typedef enum
+{
+    LOGGER_BUFFER_FREE = 0U,        // collecting records
+    LOGGER_BUFFER_READY,            // full, waiting for the bus
+    LOGGER_BUFFER_FLUSHING          // on the bus
+}logger_BufferStateType;
+
+/* the page must fill exactly one eeprom page */
+typedef char logger_PageSizeCheckType[(sizeof(logger_PageType) == LOGGER_PAGE_SIZE) ? 1 : -1];
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static logger_BufferType loggerBuffers_as[2];
+static volatile logger_BufferStateType loggerState_ae[2];
+static uint8 loggerFill_ui8;                    // buffer that collects records
+static uint8 loggerRetries_ui8;
+static twi_TransactionType loggerTransaction_s;
+
+static volatile uint16 loggerNextPage_ui16;     // ring position of the next page
+static volatile uint16 loggerSequence_ui16;     // sequence of the next page
+static boolean loggerPresent_b = FALSE;
+static volatile uint16 loggerDropped_ui16;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static twi_StatusType logger_readSequence(uint16 page_ui16, uint16 *sequence_pui16);
+static boolean logger_seal(void);
+static void logger_flushDone(twi_TransactionType *transaction_ps);
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+/* finds the newest page, needs the twi and the interrupts running */
+Std_ReturnType logger_init(void)
+{
+    uint16 first_ui16;
+    uint16 sequence_ui16;
+    uint16 low_ui16 = 0;
+    uint16 high_ui16 = LOGGER_NUM_OF_PAGES - 1U;
+
+    loggerFill_ui8 = 0;
+    loggerState_ae[0] = LOGGER_BUFFER_FREE;
+    loggerState_ae[1] = LOGGER_BUFFER_FREE;
+    loggerBuffers_as[0].page_s.count_ui8 = 0;
+    loggerBuffers_as[1].page_s.count_ui8 = 0;
+    loggerNextPage_ui16 = 0;
+    loggerSequence_ui16 = 0;
+    loggerPresent_b = FALSE;
+
+    if ((logger_readSequence(0, &first_ui16) != TWI_STATUS_OK) ||
+        (logger_readSequence(1, &sequence_ui16) != TWI_STATUS_OK))
+    {
+        return E_NOT_OK;
+    }
+    loggerPresent_b = TRUE;
+
+    /* two pages in a row with the same sequence are never written, the device is empty */
+    if ((first_ui16 == LOGGER_ERASED_SEQUENCE) && (sequence_ui16 == LOGGER_ERASED_SEQUENCE))
+    {
+        return E_OK;
+    }
+
+    /* last page p with seq[p] == seq[0] + p, page 0 always matches */
+    while (low_ui16 < high_ui16)
+    {
+        uint16 middle_ui16 = (uint16)((low_ui16 + high_ui16 + 1U) / 2U);
+
+        if (logger_readSequence(middle_ui16, &sequence_ui16) != TWI_STATUS_OK)
+        {
+            loggerPresent_b = FALSE;
+            return E_NOT_OK;
+        }
+        if (sequence_ui16 == (uint16)(first_ui16 + middle_ui16))
+        {
+            low_ui16 = middle_ui16;
+        }
+        else
+        {
+            high_ui16 = (uint16)(middle_ui16 - 1U);
+        }
+    }
+
+    loggerNextPage_ui16 = (uint16)((low_ui16 + 1U) % LOGGER_NUM_OF_PAGES);
+    loggerSequence_ui16 = (uint16)(first_ui16 + low_ui16 + 1U);
+    return E_OK;
+}
+
+/* stores a record in the RAM page, never waits. E_NOT_OK if both pages are still busy. */
+Std_ReturnType logger_add(const logger_RecordType *record_ps)
+{
+    logger_PageType *page_ps = &loggerBuffers_as[loggerFill_ui8].page_s;
+
+    if ((page_ps->count_ui8 >= LOGGER_RECORDS_PER_PAGE) && (logger_seal() == FALSE))
+    {
+        loggerDropped_ui16++;
+        return E_NOT_OK;
+    }
+
+    page_ps = &loggerBuffers_as[loggerFill_ui8].page_s;
+    page_ps->records_as[page_ps->count_ui8++] = *record_ps;
+
+    if (page_ps->count_ui8 >= LOGGER_RECORDS_PER_PAGE)
+    {
+        (void)logger_seal();
+    }
+    return E_OK;
+}
+
+/* writes a partly filled page too, e.g. before the power goes */
+void logger_flush(void)
+{
+    if (loggerBuffers_as[loggerFill_ui8].page_s.count_ui8 != 0)
+    {
+        (void)logger_seal();
+    }
+}
+
+/* starts the write of a ready page, call it from the main loop */
+void logger_task(void)
+{
+    uint8 flush_ui8 = loggerFill_ui8 ^ 1U;
+    logger_BufferType *buffer_ps = &loggerBuffers_as[flush_ui8];
+    uint16 address_ui16;
+    uint8 record_ui8;
+    uint8 byte_ui8;
+    uint8 checksum_ui8 = 0;
+
+    twi_checkTimeout();
+
+    if ((loggerPresent_b == FALSE) || (loggerState_ae[flush_ui8] != LOGGER_BUFFER_READY))
+    {
+        return;
+    }
+
+    address_ui16 = (uint16)(loggerNextPage_ui16 * LOGGER_PAGE_SIZE);
+    buffer_ps->address_aui8[0] = (uint8)(address_ui16 >> 8);
+    buffer_ps->address_aui8[1] = (uint8)address_ui16;
+    buffer_ps->page_s.sequence_ui16 = loggerSequence_ui16;
+    for (record_ui8 = 0; record_ui8 < buffer_ps->page_s.count_ui8; record_ui8++)
+    {
+        const uint8 *data_pui8 = (const uint8 *)&buffer_ps->page_s.records_as[record_ui8];
+
+        for (byte_ui8 = 0; byte_ui8 < sizeof(logger_RecordType); byte_ui8++)
+        {
+            checksum_ui8 ^= data_pui8[byte_ui8];
+        }
+    }
+    buffer_ps->page_s.checksum_ui8 = checksum_ui8;
+
+    loggerTransaction_s.address_ui8 = LOGGER_EEPROM_ADDRESS;
+    loggerTransaction_s.writeData_pui8 = (const uint8 *)buffer_ps;
+    loggerTransaction_s.writeLength_ui8 = sizeof(logger_BufferType);
+    loggerTransaction_s.readLength_ui8 = 0;
+    loggerTransaction_s.callback_pf = logger_flushDone;
+
+    loggerState_ae[flush_ui8] = LOGGER_BUFFER_FLUSHING;
+    if (twi_submit(&loggerTransaction_s) != E_OK)
+    {
+        loggerState_ae[flush_ui8] = LOGGER_BUFFER_READY;
+    }
+}
+
+uint16 logger_getDroppedCount(void)
+{
+    uint16 dropped_ui16;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        dropped_ui16 = loggerDropped_ui16;
+    }
+    return dropped_ui16;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+static twi_StatusType logger_readSequence(uint16 page_ui16, uint16 *sequence_pui16)
+{
+    twi_TransactionType transaction_s;
+    uint16 address_ui16 = (uint16)(page_ui16 * LOGGER_PAGE_SIZE);
+    uint8 address_aui8[EEPROM_ADDR_2_BYTES];
+
+    address_aui8[0] = (uint8)(address_ui16 >> 8);
+    address_aui8[1] = (uint8)address_ui16;
+
+    transaction_s.address_ui8 = LOGGER_EEPROM_ADDRESS;
+    transaction_s.writeData_pui8 = address_aui8;
+    transaction_s.writeLength_ui8 = sizeof(address_aui8);
+    transaction_s.readData_pui8 = (uint8 *)sequence_pui16;
+    transaction_s.readLength_ui8 = sizeof(uint16);
+    return twi_transfer(&transaction_s);
+}
+
+/* hands the collecting page over to logger_task() if the other one is free */
+static boolean logger_seal(void)
+{
+    uint8 other_ui8 = loggerFill_ui8 ^ 1U;
+
+    if (loggerState_ae[other_ui8] != LOGGER_BUFFER_FREE)
+    {
+        return FALSE;
+    }
+
+    loggerRetries_ui8 = 0;
+    loggerState_ae[loggerFill_ui8] = LOGGER_BUFFER_READY;
+    loggerBuffers_as[other_ui8].page_s.count_ui8 = 0;
+    loggerFill_ui8 = other_ui8;
+    return TRUE;
+}
+
+/* twi completion, interrupt context */
+static void logger_flushDone(twi_TransactionType *transaction_ps)
+{
+    uint8 flush_ui8 = loggerFill_ui8 ^ 1U;
+
+    if (transaction_ps->status_e == TWI_STATUS_OK)
+    {
+        loggerNextPage_ui16 = (uint16)((loggerNextPage_ui16 + 1U) % LOGGER_NUM_OF_PAGES);
+        loggerSequence_ui16++;
+        loggerState_ae[flush_ui8] = LOGGER_BUFFER_FREE;
+    }
+    else if (++loggerRetries_ui8 < LOGGER_RETRIES)
+    {
+        loggerState_ae[flush_ui8] = LOGGER_BUFFER_READY;
+    }
+    else
+    {
+        loggerDropped_ui16 += loggerBuffers_as[flush_ui8].page_s.count_ui8;
+        loggerState_ae[flush_ui8] = LOGGER_BUFFER_FREE;
+    }
+}
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,80 @@
+/* *************************************************************************************************
+ * file:        logger.h
+ *
+ *          The data logger module header, samples into an external I2C eeprom.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the eeprom is a ring of pages, every page is written in one page write:
+ *
+ *          byte  size  content
+ *          ----+-----+----------------------------------------------
+ *           0     2    sequence, +1 for every page written
+ *           2     1    number of records in this page
+ *           3     1    checksum, xor over the records
+ *           4    28    LOGGER_RECORDS_PER_PAGE records
+ *
+ *          the pages are written in ring order, so every page wears the same. the newest
+ *          page is the last one whose sequence still counts up from page 0.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _LOGGER_H_
+#define _LOGGER_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+#include "../twi/twimaster.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* 24C32: 4kB, 32 byte pages, two address bytes */
+#define LOGGER_EEPROM_ADDRESS       EDID_EEPROM_ADDRESS
+#define LOGGER_EEPROM_SIZE          (4096U)
+#define LOGGER_PAGE_SIZE            (32U)
+#define LOGGER_NUM_OF_PAGES         (LOGGER_EEPROM_SIZE / LOGGER_PAGE_SIZE)
+
+#define LOGGER_HEADER_SIZE          (4U)
+#define LOGGER_RECORD_SIZE          (7U)
+#define LOGGER_RECORDS_PER_PAGE     ((LOGGER_PAGE_SIZE - LOGGER_HEADER_SIZE) / LOGGER_RECORD_SIZE)
+
+/* a page that is not taken this often is dropped */
+#define LOGGER_RETRIES              (3U)
+
+#if (EEPROM_WIDTH != EEPROM_ADDR_2_BYTES)
+#error "logger: the page layout needs an eeprom with two address bytes"
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    uint16  uptimeSeconds_ui16;
+    uint16  packMilliVolt_ui16;
+    uint16  minCellMilliVolt_ui16;
+    uint8   socPercent_ui8;
+}logger_RecordType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+Std_ReturnType logger_init(void);
+Std_ReturnType logger_add(const logger_RecordType *record_ps);
+void logger_flush(void);
+void logger_task(void);
+uint16 logger_getDroppedCount(void);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _LOGGER_H_ */
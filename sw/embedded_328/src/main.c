@@ -1,243 +1,248 @@
 #include "../inc/std_types.h"
 #include "uart/uart.h"
 #include "twi/twimaster.h"
+#include "twi/twi.h"
+#include "timer/timer.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
-#include <stdio.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
 #include <stdlib.h>
 #include <util/delay.h>
-#include "gpio/gpio.h"
-
 #include "adc/adc.h"
-#include "adc/adc_lcfg.h"
-
-#define LED_CHANNEL_0   GPIO_CHANNEL_PB4
-#define LED_CHANNEL_1   GPIO_CHANNEL_PB3
-#define LED_CHANNEL_2   GPIO_CHANNEL_PB2
-#define LED_CHANNEL_3   GPIO_CHANNEL_PB1
-#define LED_CHANNEL_4   GPIO_CHANNEL_PB0
-
-#define DIGIT_DIFF 8
-#define in_between(x, y, z) (x > (y - z)) && (x < (y + z))
-#define ADC_DIGITS (4095)
-#define ADC_REF_VOLTAGE (5.0)
-#define UBAT_DIVIDER (34.8)
-#define ubat_digit_to_volt(x) (((float32)(x * ADC_REF_VOLTAGE) / ADC_DIGITS) * UBAT_DIVIDER)
-
-typedef enum
-{
-   LIPO_CELL_1 = 358,
-   LIPO_CELL_2 = 494,
-   LIPO_CELL_3 = 572,
-   LIPO_CELL_4 = 607,
-   LIPO_CELL_5 = 638,
-   LIPO_CELL_6 = 650,
-   LIPO_CELL_NONE = 0
-}lipoCellDigitsType;
-
-typedef enum
-{
-   SWITCH_CELL_NONE = 0,
-   SWITCH_CELL_1,
-   SWITCH_CELL_2,
-   SWITCH_CELL_3,
-   SWITCH_CELL_4,
-   SWITCH_CELL_5,
-   SWITCH_CELL_6,
-}lipoCellSwitchType;
-
-typedef enum
-{
-   LED_FULL             = 0,
-   LED_UNDER_80_PERCENT = 1,
-   LED_UNDER_60_PERCENT = 2,
-   LED_UNDER_40_PERCENT = 3,
-   LED_UNDER_20_PERCENT = 4,
-   LED_INVALID          = 5
-}ledPercentIndicatorType;
-
-void showLedStatus(ledPercentIndicatorType led)
-{
-   static uint8 blink = 0;
-   switch(led)
-   {
-   case LED_FULL:
-      gpio_WriteChannel(LED_CHANNEL_0, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_1, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_2, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_3, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_4, TRUE);
-      break;
-
-   case LED_UNDER_80_PERCENT:
-      gpio_WriteChannel(LED_CHANNEL_0, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_1, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_2, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_3, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_4, TRUE);
-      break;
-
-   case LED_UNDER_60_PERCENT:
-      gpio_WriteChannel(LED_CHANNEL_0, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_1, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_2, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_3, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_4, TRUE);
-      break;
-
-   case LED_UNDER_40_PERCENT:
-      gpio_WriteChannel(LED_CHANNEL_0, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_1, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_2, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_3, TRUE);
-      gpio_WriteChannel(LED_CHANNEL_4, TRUE);
-      break;
-
-   case LED_UNDER_20_PERCENT:
-      gpio_WriteChannel(LED_CHANNEL_0, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_1, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_2, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_3, FALSE);
-      gpio_WriteChannel(LED_CHANNEL_4, TRUE);
-      break;
-
-   case LED_INVALID:
-      if(blink % 2 == 0)
-      {
-         gpio_WriteChannel(LED_CHANNEL_0, TRUE);
-      }
-      else
-      {
-         gpio_WriteChannel(LED_CHANNEL_0, FALSE);
-      }
-      blink++;
-      break;
-   default:
-
-      break;
-   }
-}
-
-
-/* 80%, 60%, 40%, 20% of 1 to 6 Cells */
-float32 cellArray[6][4] =
-{
-      { 4.02,   3.84,    3.66,    3.48}, /* 1 Cell */
-      { 8.04,   7.68,    7.32,    6.96}, /* 2 Cells */
-      {12.06,  11.52,   10.98,   10.44}, /* 3 Cells */
-      {16.08,  15.36,   14.64,   13.92}, /* 4 Cells */
-      {20.10,  19.20,   18.30,   17.40}, /* 5 Cells */
-      {24.12,  23.04,   21.96,   20.88}, /* 6 Cells */
-};
-
-lipoCellSwitchType checkLipoSwitch(uint16 adc_channel)
-{
-   lipoCellSwitchType lipoSwitch = SWITCH_CELL_NONE;
-   if(in_between(adc_channel, LIPO_CELL_1, DIGIT_DIFF))
-   {
-      lipoSwitch = SWITCH_CELL_1;
-   }
-   else if(in_between(adc_channel, LIPO_CELL_2, DIGIT_DIFF))
-   {
-      lipoSwitch = SWITCH_CELL_2;
-   }
-   else if(in_between(adc_channel, LIPO_CELL_3, DIGIT_DIFF))
-   {
-      lipoSwitch = SWITCH_CELL_3;
-   }
-   else if(in_between(adc_channel, LIPO_CELL_4, DIGIT_DIFF))
-   {
-      lipoSwitch = SWITCH_CELL_4;
-   }
-   else if(in_between(adc_channel, LIPO_CELL_5, DIGIT_DIFF))
-   {
-      lipoSwitch = SWITCH_CELL_5;
-   }
-   else if(in_between(adc_channel, LIPO_CELL_6, DIGIT_DIFF))
-   {
-      lipoSwitch = SWITCH_CELL_6;
-   }
-   else
-   {
-      lipoSwitch = SWITCH_CELL_NONE;
-   }
-   return lipoSwitch;
-}
-
-
-
-ledPercentIndicatorType checkUbatState(lipoCellSwitchType cells, float32 ubatVoltage)
-{
-   char sprintfBuffer[100];
-
-   ledPercentIndicatorType ledPercentIndicator;
-
-   ledPercentIndicator = LED_FULL;
-
-   if(ubatVoltage < cellArray[cells - 1][0])
-   {
-      ledPercentIndicator = LED_UNDER_80_PERCENT;
-   }
-   if(ubatVoltage < cellArray[cells - 1][1])
-   {
-      ledPercentIndicator = LED_UNDER_60_PERCENT;
-   }
-   if(ubatVoltage < cellArray[cells - 1][2])
-   {
-      ledPercentIndicator = LED_UNDER_40_PERCENT;
-   }
-   if(ubatVoltage < cellArray[cells - 1][3])
-   {
-      ledPercentIndicator = LED_UNDER_20_PERCENT;
-   }
-
-   return ledPercentIndicator;
-}
+#include "hal/hal.h"
+#include "stack/stack.h"
+#include "trace/trace.h"
+#include "perf/perf.h"
+#include "indicator/indicator.h"
+#include "soc/soc.h"
+#include "balance/balance.h"
+#include "telemetry/telemetry.h"
+#include "logger/logger.h"
+#include "stats/stats.h"
+#include "history/history.h"
+#include "settings/settings.h"
+#include "command/command.h"
+#include "format/format.h"
+
+#define BALANCE_MODE                STD_ON   /* weakest cell from the balance lead drives the display */
+#define LOGGER_MODE                 STD_ON   /* samples into the external i2c eeprom */
+#define STATS_MODE                  STD_ON   /* usage statistics in the internal eeprom */
+#define HISTORY_MODE                STD_ON   /* min/avg/max history of the cell voltage */
+#define COMMAND_MODE                STD_ON   /* live reconfiguration and dump, see command/command.h */
+#define LOG_INTERVAL_S              (10U)    /* one record every 10s, a 24C32 holds 85 minutes */
 
 int main()
 {
    uint16 lipoSwitchChannel = 0;
    uint16 ubatChannel = 0;
-   char sprintfBuf[100];
+   uint16 rawChannel = 0;
    uint8 lipo_switch = 0;
-   float32 ubatVoltage;
    uint8 led = 0;
-
-
-   uart_init(RECEPTION_DISABLED, TRANSMISSION_ENABLED, INTERRUPT_DISABLED);
-   uart_puts("\n\r");
-   gpio_init();
-   adc_init(ADC_CALLBACK_NULL_PTR);
+#if (LOGGER_MODE == STD_ON)
+   logger_RecordType logRecord;
+   uint32 logSeconds = 0;
+#endif
+   uint8 socPercent = 0;
+   uint16 levelChannel = 0;
+   uint16 levelCellMilliVolt = 0;
+   balance_ResultType balance;
+   boolean balanceValid = FALSE;
+   boolean displayDark = FALSE;
+#if (STATS_MODE == STD_ON)
+   timer_TickType statsTick = 0;
+#endif
+#if (HISTORY_MODE == STD_ON)
+   uint32 historySeconds = 0;
+#endif
+   timer_TickType cycleTick = 0;
+   uint16 loopCount = 0;
+
+
+   stack_paint();
+   uart_init(RECEPTION_ENABLED, TRANSMISSION_ENABLED, INTERRUPT_ENABLED);
+   format_string_P(PSTR("\n\r"));
+   hal_init();
+   timer_init();
+   i2c_init();
+   soc_init();
+   settings_init();
+#if (BALANCE_MODE == STD_ON)
+   balance_init();
+#endif
+#if (HISTORY_MODE == STD_ON)
+   history_init();
+#endif
+#if (STATS_MODE == STD_ON)
+   stats_init();
+   format_string_P(PSTR("power on: "));
+   format_unsigned(stats_get()->powerOnCount_ui16);
+   format_string_P(PSTR(", runtime: "));
+   format_unsigned(stats_get()->runtimeSeconds_ui32);
+   format_string_P(PSTR(" s, below "));
+   format_unsigned(STATS_LOW_PERCENT);
+   format_string_P(PSTR("%: "));
+   format_unsigned(stats_get()->lowSeconds_ui32);
+   format_string_P(PSTR(" s, last session min: "));
+   format_unsigned(stats_get()->lastSessionMinMilliVolt_ui16);
+   format_string_P(PSTR(" mV\n\r"));
+#endif
 
 
    sei(); /* Enable the interrupts */
+#if (LOGGER_MODE == STD_ON)
+   (void)logger_init();
+#endif
+#if (STATS_MODE == STD_ON)
+   statsTick = timer_getTicks();
+#endif
    while(1)
    {
-      adc_setChannel(ADC_CHANNEL_0);
-      _delay_ms(100);
-      lipoSwitchChannel = adc_read10bit();
-      _delay_ms(100);
-      lipo_switch = checkLipoSwitch(lipoSwitchChannel);
-
-      _delay_ms(100);
-      adc_setChannel(ADC_CHANNEL_1);
-      ubatChannel = adc_read10bit();
-      _delay_ms(100);
-      ubatVoltage = ubat_digit_to_volt(ubatChannel);
+      loopCount++;
+      trace_event(TRACE_LOOP, loopCount);
+      perf_count(loops_ui16);
+      cycleTick = timer_getTicks();
+      adc_setAverage((adc_AverageType_e)settings_get()->filterDepth_ui8);
+      rawChannel = hal_readChannel(HAL_CHANNEL_UBAT);
+      (void)settings_calibrate(ubat_digit_to_millivolt(rawChannel));
+      ubatChannel = settings_correct(rawChannel);
+
+#if (CELL_DETECTION_AUTO == STD_ON)
+      lipo_switch = latchLipoCells(detectLipoCells(ubat_digit_to_millivolt(ubatChannel)));
+#else
+      lipo_switch = SWITCH_CELL_NONE;
+#endif
+      /* the switch is only needed while the cell count is not latched */
+      if(lipo_switch == SWITCH_CELL_NONE)
+      {
+         lipoSwitchChannel = hal_readChannel(HAL_CHANNEL_SWITCH);
+         lipo_switch = debounceLipoSwitch(checkLipoSwitch(lipoSwitchChannel));
+      }
 
       if(lipo_switch > SWITCH_CELL_NONE)
       {
-         led = checkUbatState(lipo_switch, ubatVoltage);
+         levelChannel = ubatChannel;
+         levelCellMilliVolt = ubat_digit_to_millivolt(ubatChannel) / lipo_switch;
+#if (BALANCE_MODE == STD_ON)
+         balanceValid = balance_scan(lipo_switch, ubat_digit_to_millivolt(ubatChannel), &balance);
+         if(balanceValid == TRUE)
+         {
+            /* judge the pack by its weakest cell */
+            levelCellMilliVolt = balance.minCellMilliVolt_ui16;
+            levelChannel = ubat_millivolt_to_digit((uint32)levelCellMilliVolt * lipo_switch);
+         }
+#endif
+         led = checkUbatState(lipo_switch, levelChannel);
+         socPercent = soc_getPercent(levelCellMilliVolt);
+#if (HISTORY_MODE == STD_ON)
+         /* the history only runs while a pack is recognized, one sample per second */
+         if(timer_getSeconds() != historySeconds)
+         {
+            historySeconds = timer_getSeconds();
+            history_add(levelCellMilliVolt);
+         }
+#endif
       }
       else
       {
          led = LED_INVALID;
+         socPercent = 0;
+         balanceValid = FALSE;
+      }
+      (void)telemetry_update(ubat_digit_to_millivolt(ubatChannel), (lipo_switch > SWITCH_CELL_NONE) ? (uint8)lipo_switch : 0U,
+                             socPercent, (balanceValid == TRUE) ? &balance : NULL);
+      /* a master that stops in the middle of a read must not hold the register file */
+      twi_checkTimeout();
+#if (LOGGER_MODE == STD_ON)
+      if((lipo_switch > SWITCH_CELL_NONE) && ((timer_getSeconds() - logSeconds) >= LOG_INTERVAL_S))
+      {
+         logSeconds = timer_getSeconds();
+         logRecord.uptimeSeconds_ui16 = (uint16)logSeconds;
+         logRecord.packMilliVolt_ui16 = ubat_digit_to_millivolt(ubatChannel);
+         logRecord.minCellMilliVolt_ui16 = levelCellMilliVolt;
+         logRecord.socPercent_ui8 = socPercent;
+         (void)logger_add(&logRecord);
+      }
+      logger_task();
+#endif
+#if (STATS_MODE == STD_ON)
+      /* runtime is counted while a pack is recognized */
+      if(lipo_switch > SWITCH_CELL_NONE)
+      {
+         stats_update(ubat_digit_to_millivolt(ubatChannel), socPercent, timer_elapsed(statsTick));
+      }
+      statsTick = timer_getTicks();
+#endif
+
+      if(checkDisplayIdle(led, ubatChannel) == TRUE)
+      {
+         if(displayDark == FALSE)
+         {
+            /* the pack may be unplugged any time now, save what is pending */
+#if (STATS_MODE == STD_ON)
+            stats_save();
+#endif
+#if (HISTORY_MODE == STD_ON)
+            history_save();
+#endif
+#if (LOGGER_MODE == STD_ON)
+            logger_flush();
+#endif
+            displayDark = TRUE;
+         }
+         showLedStatus(LED_OFF);
+      }
+      else
+      {
+         displayDark = FALSE;
+         showLedStatus(led);
       }
-      showLedStatus(led);
 
-      sprintf(sprintfBuf, "switch raw: %d, raw: %d, ubat voltage: %.2f, lipo cells: %d, led: %d\n\r", lipoSwitchChannel, ubatChannel, ubatVoltage, lipo_switch, led);
-      uart_puts(sprintfBuf);
-      _delay_ms(100);
+      format_string_P(PSTR("switch raw: "));
+      format_unsigned(lipoSwitchChannel);
+      format_string_P(PSTR(", raw: "));
+      format_unsigned(ubatChannel);
+      format_string_P(PSTR(", ubat voltage: "));
+      format_milliVolt(ubat_digit_to_millivolt(ubatChannel));
+      format_string_P(PSTR(", lipo cells: "));
+      format_unsigned(lipo_switch);
+      format_string_P(PSTR(", soc: "));
+      format_unsigned(socPercent);
+      format_string_P(PSTR("%, led: "));
+      format_unsigned(led);
+      format_string_P(PSTR(", twi errors: "));
+      format_unsigned(twi_getErrorCount());
+      format_string_P(PSTR(", eeprom writes saved: "));
+      format_unsigned(stats_getSavedWrites());
+      format_string_P(PSTR("\n\r"));
+      if(balanceValid == TRUE)
+      {
+         format_string_P(PSTR("min cell "));
+         format_unsigned(balance.minCell_ui8 + 1U);
+         format_string_P(PSTR(": "));
+         format_unsigned(balance.minCellMilliVolt_ui16);
+         format_string_P(PSTR(" mV, max cell: "));
+         format_unsigned(balance.maxCellMilliVolt_ui16);
+         format_string_P(PSTR(" mV, imbalance: "));
+         format_unsigned(balance.imbalanceMilliVolt_ui16);
+         format_string_P(PSTR(" mV\n\r"));
+      }
+      perf_loopTime(timer_elapsed(cycleTick));
+      /* the rest of the cycle is spent waiting for commands, idle between the interrupts.
+       * the timer tick wakes the cpu up every millisecond, a received byte earlier.
+       */
+      set_sleep_mode(SLEEP_MODE_IDLE);
+      do
+      {
+#if (COMMAND_MODE == STD_ON)
+         command_poll();
+#endif
+         sleep_enable();
+         perf_sleepBegin();
+         sleep_cpu();
+         perf_sleepEnd();
+         sleep_disable();
+      } while(timer_elapsed(cycleTick) < settings_get()->cycleMilliSeconds_ui16);
    }
    return 0;
 }
@@ -0,0 +1,98 @@
+/* *************************************************************************************************
+ * file:        perf.c
+ *
+ *          The performance counter module, counters that can be polled on a board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <string.h>
+#include <util/atomic.h>
+#include "perf.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#if ((PERF_LOOP_WINDOW & (PERF_LOOP_WINDOW - 1U)) != 0U)
+#error "perf: PERF_LOOP_WINDOW must be a power of 2"
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+perf_CountersType perf_counters_s;
+volatile boolean perf_sleeping_b = FALSE;
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static perf_LoopTimeType perf_loopTime_s;       // last complete window
+
+/* window in progress */
+static uint32 perf_loopSum_ui32;
+static uint16 perf_loopMin_ui16 = 0xFFFFU;
+static uint16 perf_loopMax_ui16;
+static uint16 perf_loopCount_ui16;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+/* once per main loop cycle, after the work and before the wait */
+void perf_loopTime(uint16 ticks_ui16)
+{
+    perf_loopSum_ui32 += ticks_ui16;
+    if (ticks_ui16 < perf_loopMin_ui16)
+    {
+        perf_loopMin_ui16 = ticks_ui16;
+    }
+    if (ticks_ui16 > perf_loopMax_ui16)
+    {
+        perf_loopMax_ui16 = ticks_ui16;
+    }
+
+    if (++perf_loopCount_ui16 == PERF_LOOP_WINDOW)
+    {
+        perf_loopTime_s.min_ui16 = perf_loopMin_ui16;
+        perf_loopTime_s.avg_ui16 = (uint16)(perf_loopSum_ui32 / PERF_LOOP_WINDOW);
+        perf_loopTime_s.max_ui16 = perf_loopMax_ui16;
+        perf_loopSum_ui32 = 0;
+        perf_loopMin_ui16 = 0xFFFFU;
+        perf_loopMax_ui16 = 0;
+        perf_loopCount_ui16 = 0;
+    }
+}
+
+void perf_get(perf_CountersType *counters_ps)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        memcpy(counters_ps, &perf_counters_s, sizeof(perf_CountersType));
+    }
+}
+
+/* all zero until the first window is complete */
+const perf_LoopTimeType *perf_getLoopTime(void)
+{
+    return &perf_loopTime_s;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+
+/* ************************************ E O F *************************************************** */
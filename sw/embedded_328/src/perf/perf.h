@@ -0,0 +1,99 @@
+/* *************************************************************************************************
+ * file:        perf.h
+ *
+ *          The performance counter module header, counters that can be polled on a board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the counters are 16 bit and wrap, a reader takes the difference of two reads.
+ *          each one is incremented by perf_count() in one place and from one context only,
+ *          the main loop or one interrupt, so the increment needs no lock. perf_get() copies
+ *          them with the interrupts masked.
+ *
+ *          the loop time is the busy part of a main loop cycle in timer ticks, without the
+ *          wait for the next cycle. min, avg and max are taken over PERF_LOOP_WINDOW cycles
+ *          and kept until the next window is complete.
+ *
+ *          perf_sleepBegin() and perf_sleepEnd() enclose sleep_cpu(). the tick interrupt
+ *          counts the ticks that woke the cpu up from sleep, the rest of the ticks was awake.
+ *
+ *          the 328 reports them in its telemetry. with PERF_MODE STD_OFF in perf_cfg.h the
+ *          counters compile to nothing, this header is shared with the attiny84.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _PERF_H_
+#define _PERF_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+#include "perf_cfg.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* ADMUX selects one of 8 channels */
+#define PERF_ADC_CHANNELS           (8U)
+
+#if (PERF_MODE == STD_ON)
+#define perf_count(counter)         (perf_counters_s.counter++)
+#define perf_sleepBegin()           (perf_sleeping_b = TRUE)
+#define perf_sleepEnd()             (perf_sleeping_b = FALSE)
+#define perf_tick()                 do { if (perf_sleeping_b == TRUE) { perf_counters_s.sleepTicks_ui16++; } } while (0)
+#else
+#define perf_count(counter)         ((void)0)
+#define perf_sleepBegin()           ((void)0)
+#define perf_sleepEnd()             ((void)0)
+#define perf_tick()                 ((void)0)
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    uint16  loops_ui16;                                     // main loop cycles
+    uint16  adcConversions_aui16[PERF_ADC_CHANNELS];        // adc_read10bit() by channel
+    uint16  isrUartRx_ui16;
+    uint16  isrUartUdre_ui16;
+    uint16  isrTwi_ui16;
+    uint16  isrAdc_ui16;
+    uint16  uartTxFull_ui16;                                // uart_putc() had to wait for room
+    uint16  twiNacks_ui16;                                  // polled transfers not acknowledged
+    uint16  eepromWrites_ui16;                              // eeprom_update_*() calls
+    uint16  sleepTicks_ui16;                                // ticks that woke the cpu up
+}perf_CountersType;
+
+typedef struct
+{
+    uint16  min_ui16;
+    uint16  avg_ui16;
+    uint16  max_ui16;
+}perf_LoopTimeType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+#if (PERF_MODE == STD_ON)
+extern perf_CountersType perf_counters_s;
+extern volatile boolean perf_sleeping_b;
+#endif
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+#if (PERF_MODE == STD_ON)
+void perf_loopTime(uint16 ticks_ui16);
+void perf_get(perf_CountersType *counters_ps);
+const perf_LoopTimeType *perf_getLoopTime(void);
+#endif
+
+/* ************************************ E O F *************************************************** */
+#endif /* _PERF_H_ */
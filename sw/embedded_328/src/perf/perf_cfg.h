@@ -0,0 +1,33 @@
+/* *************************************************************************************************
+ * file:        perf_cfg.h
+ *
+ *          The performance counter module configuration of the ATmega328 board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _PERF_CFG_H_
+#define _PERF_CFG_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define PERF_MODE                   STD_ON
+
+/* main loop cycles per min/avg/max of the loop time, a power of 2 */
+#define PERF_LOOP_WINDOW            (16U)
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _PERF_CFG_H_ */
@@ -0,0 +1,217 @@
+/* *************************************************************************************************
+ * file:        settings.c
+ *
+ *          The settings module, parameters that can be tuned at runtime.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent performance counters
+ *
+ * notes:
+ *          settings change a few times in the life of the device, so a single crc protected
+ *          record is enough. eeprom_update_block() only programs the bytes that changed.
+ *
+ *          the calibration needs the uncorrected pack voltage, which only the main loop
+ *          knows. settings_requestCalibration() stores the true voltage, the next call of
+ *          settings_calibrate() with the measured one computes the gain.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include "settings.h"
+#include "../perf/perf.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define SETTINGS_CRC_LENGTH     (sizeof(settings_DataType) - sizeof(uint16))
+
+#define SETTINGS_NO_CALIBRATION (0U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static settings_DataType settings_eeprom_s EEMEM;
+
+static const uint8 settings_defaultThresholds_aui8[SETTINGS_NUM_OF_THRESHOLDS] = SETTINGS_DEFAULT_THRESHOLDS;
+
+static settings_DataType settings_data_s;
+static uint8 settings_revision_ui8;
+static uint16 settings_calibrationMilliVolt_ui16;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static uint16 settings_crc(const settings_DataType *data_ps);
+static void settings_save(void);
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void settings_init(void)
+{
+    eeprom_read_block(&settings_data_s, &settings_eeprom_s, sizeof(settings_data_s));
+    if (settings_data_s.crc_ui16 != settings_crc(&settings_data_s))
+    {
+        settings_reset();
+    }
+    settings_calibrationMilliVolt_ui16 = SETTINGS_NO_CALIBRATION;
+}
+
+const settings_DataType *settings_get(void)
+{
+    return &settings_data_s;
+}
+
+uint8 settings_getRevision(void)
+{
+    return settings_revision_ui8;
+}
+
+/* for changes kept outside the record, e.g. the chemistry, that invalidate derived values */
+void settings_changed(void)
+{
+    settings_revision_ui8++;
+}
+
+void settings_reset(void)
+{
+    uint8 level_ui8;
+
+    for (level_ui8 = 0; level_ui8 < SETTINGS_NUM_OF_THRESHOLDS; level_ui8++)
+    {
+        settings_data_s.thresholdPercent_aui8[level_ui8] = settings_defaultThresholds_aui8[level_ui8];
+    }
+    settings_data_s.cycleMilliSeconds_ui16 = SETTINGS_DEFAULT_CYCLE_MS;
+    settings_data_s.filterDepth_ui8 = SETTINGS_DEFAULT_FILTER_DEPTH;
+    settings_data_s.displayMode_ui8 = SETTINGS_DEFAULT_DISPLAY_MODE;
+    settings_data_s.ubatGain_ui16 = SETTINGS_GAIN_ONE;
+    settings_save();
+}
+
+/* the thresholds must fall strictly from level to level and stay inside 1..99% */
+Std_ReturnType settings_setThresholds(const uint8 *percent_pui8)
+{
+    uint8 level_ui8;
+    uint8 above_ui8 = 100U;
+
+    for (level_ui8 = 0; level_ui8 < SETTINGS_NUM_OF_THRESHOLDS; level_ui8++)
+    {
+        if ((percent_pui8[level_ui8] == 0U) || (percent_pui8[level_ui8] >= above_ui8))
+        {
+            return E_NOT_OK;
+        }
+        above_ui8 = percent_pui8[level_ui8];
+    }
+
+    for (level_ui8 = 0; level_ui8 < SETTINGS_NUM_OF_THRESHOLDS; level_ui8++)
+    {
+        settings_data_s.thresholdPercent_aui8[level_ui8] = percent_pui8[level_ui8];
+    }
+    settings_save();
+    return E_OK;
+}
+
+Std_ReturnType settings_setCycle(uint16 milliSeconds_ui16)
+{
+    if ((milliSeconds_ui16 < SETTINGS_CYCLE_MIN_MS) || (milliSeconds_ui16 > SETTINGS_CYCLE_MAX_MS))
+    {
+        return E_NOT_OK;
+    }
+    settings_data_s.cycleMilliSeconds_ui16 = milliSeconds_ui16;
+    settings_save();
+    return E_OK;
+}
+
+Std_ReturnType settings_setFilterDepth(uint8 depth_ui8)
+{
+    if (depth_ui8 > SETTINGS_FILTER_DEPTH_MAX)
+    {
+        return E_NOT_OK;
+    }
+    settings_data_s.filterDepth_ui8 = depth_ui8;
+    settings_save();
+    return E_OK;
+}
+
+Std_ReturnType settings_setDisplayMode(uint8 mode_ui8)
+{
+    if (mode_ui8 >= SETTINGS_NUM_OF_DISPLAY_MODES)
+    {
+        return E_NOT_OK;
+    }
+    settings_data_s.displayMode_ui8 = mode_ui8;
+    settings_save();
+    return E_OK;
+}
+
+void settings_requestCalibration(uint16 packMilliVolt_ui16)
+{
+    settings_calibrationMilliVolt_ui16 = packMilliVolt_ui16;
+}
+
+/* call it every cycle with the uncorrected pack voltage. returns E_OK if a pending
+ * calibration was carried out, E_NOT_OK if none was pending or the gain is out of range.
+ */
+Std_ReturnType settings_calibrate(uint16 rawMilliVolt_ui16)
+{
+    uint32 gain_ui32;
+
+    if ((settings_calibrationMilliVolt_ui16 == SETTINGS_NO_CALIBRATION) || (rawMilliVolt_ui16 == 0U))
+    {
+        return E_NOT_OK;
+    }
+
+    gain_ui32 = ((uint32)settings_calibrationMilliVolt_ui16 << SETTINGS_GAIN_SHIFT) / rawMilliVolt_ui16;
+    settings_calibrationMilliVolt_ui16 = SETTINGS_NO_CALIBRATION;
+    if ((gain_ui32 < SETTINGS_GAIN_MIN) || (gain_ui32 > SETTINGS_GAIN_MAX))
+    {
+        return E_NOT_OK;
+    }
+
+    settings_data_s.ubatGain_ui16 = (uint16)gain_ui32;
+    settings_save();
+    return E_OK;
+}
+
+/* applies the calibrated gain to a raw battery channel reading */
+uint16 settings_correct(uint16 channel_ui16)
+{
+    return (uint16)(((uint32)channel_ui16 * settings_data_s.ubatGain_ui16 + (SETTINGS_GAIN_ONE / 2U)) >> SETTINGS_GAIN_SHIFT);
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+static uint16 settings_crc(const settings_DataType *data_ps)
+{
+    const uint8 *data_pui8 = (const uint8 *)data_ps;
+    uint16 crc_ui16 = 0xFFFFU;
+    uint8 byte_ui8;
+
+    for (byte_ui8 = 0; byte_ui8 < SETTINGS_CRC_LENGTH; byte_ui8++)
+    {
+        crc_ui16 = _crc16_update(crc_ui16, data_pui8[byte_ui8]);
+    }
+    return crc_ui16;
+}
+
+static void settings_save(void)
+{
+    settings_data_s.crc_ui16 = settings_crc(&settings_data_s);
+    perf_count(eepromWrites_ui16);
+    eeprom_update_block(&settings_data_s, &settings_eeprom_s, sizeof(settings_data_s));
+    settings_revision_ui8++;
+}
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,89 @@
+/* *************************************************************************************************
+ * file:        settings.h
+ *
+ *          The settings module header, parameters that can be tuned at runtime.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the settings are changed over the uart, see command/command.h, and kept in the
+ *          internal eeprom. every accepted change increments the revision, users of a
+ *          setting compare it with the revision they cached their derived values for.
+ *          the chemistry is not part of the record, soc.c keeps it on its own.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _SETTINGS_H_
+#define _SETTINGS_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define SETTINGS_NUM_OF_THRESHOLDS      (4U)
+
+/* defaults, used if the eeprom holds no valid record */
+#define SETTINGS_DEFAULT_THRESHOLDS     {80U, 60U, 40U, 20U}
+#define SETTINGS_DEFAULT_CYCLE_MS       (500U)
+#define SETTINGS_DEFAULT_FILTER_DEPTH   (2U)        // ADC_AVERAGE_4_SAMPLES
+#define SETTINGS_DEFAULT_DISPLAY_MODE   (1U)        // DISPLAY_MODE_DOT
+
+/* limits of the main loop cycle, the display timings follow it */
+#define SETTINGS_CYCLE_MIN_MS           (100U)
+#define SETTINGS_CYCLE_MAX_MS           (2000U)
+
+/* 2^depth adc samples are averaged, 2^5 * 1023 still fits into 16 bit */
+#define SETTINGS_FILTER_DEPTH_MAX       (5U)
+
+#define SETTINGS_NUM_OF_DISPLAY_MODES   (3U)
+
+/* gain of the battery voltage divider in 1/4096, calibration may correct +-10% */
+#define SETTINGS_GAIN_SHIFT             (12U)
+#define SETTINGS_GAIN_ONE               (1U << SETTINGS_GAIN_SHIFT)
+#define SETTINGS_GAIN_MIN               (3686U)
+#define SETTINGS_GAIN_MAX               (4506U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    uint8   thresholdPercent_aui8[SETTINGS_NUM_OF_THRESHOLDS];  // falling, one per led level
+    uint16  cycleMilliSeconds_ui16;
+    uint8   filterDepth_ui8;
+    uint8   displayMode_ui8;
+    uint16  ubatGain_ui16;
+    uint16  crc_ui16;
+}settings_DataType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void settings_init(void);
+const settings_DataType *settings_get(void);
+uint8 settings_getRevision(void);
+void settings_changed(void);
+void settings_reset(void);
+
+Std_ReturnType settings_setThresholds(const uint8 *percent_pui8);
+Std_ReturnType settings_setCycle(uint16 milliSeconds_ui16);
+Std_ReturnType settings_setFilterDepth(uint8 depth_ui8);
+Std_ReturnType settings_setDisplayMode(uint8 mode_ui8);
+
+void settings_requestCalibration(uint16 packMilliVolt_ui16);
+Std_ReturnType settings_calibrate(uint16 rawMilliVolt_ui16);
+uint16 settings_correct(uint16 channel_ui16);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _SETTINGS_H_ */
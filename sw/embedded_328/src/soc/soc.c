@@ -0,0 +1,166 @@
+/* *************************************************************************************************
+ * file:        soc.c
+ *
+ *          The state of charge module.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent chemistry selection, active profile cached in ram
+ *          19.10.2026  agent performance counters
+ *
+ * notes:
+ *          both directions do a binary search for the curve segment and a single integer
+ *          interpolation inside it. values outside the curve are clamped to its ends.
+ *          the chemistry is read from eeprom once in soc_init().
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/pgmspace.h>
+#include <avr/eeprom.h>
+#include "soc.h"
+#include "../perf/perf.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define soc_readMilliVolt(p)    (pgm_read_word(&(p)->cellMilliVolt_ui16))
+#define soc_readPercent(p)      (pgm_read_byte(&(p)->percent_ui8))
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static uint8 soc_chemistryEeprom_ui8 EEMEM = SOC_CHEMISTRY_LIPO;
+
+static soc_ChemistryType soc_chemistry_e;
+static soc_ProfileType   soc_profile_s;
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static uint16 soc_interpolate(uint16 x_ui16, uint16 x0_ui16, uint16 x1_ui16, uint16 y0_ui16, uint16 y1_ui16);
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void soc_init(void)
+{
+    soc_ChemistryType chemistry_e = (soc_ChemistryType)eeprom_read_byte(&soc_chemistryEeprom_ui8);
+
+    /* an erased or invalid cell falls back to standard LiPo */
+    if (chemistry_e >= SOC_CHEMISTRY_COUNT)
+    {
+        chemistry_e = SOC_CHEMISTRY_LIPO;
+    }
+
+    soc_chemistry_e = chemistry_e;
+    memcpy_P(&soc_profile_s, &((const soc_ProfileType*)soc_getLcfgData())[chemistry_e], sizeof(soc_ProfileType));
+}
+
+void soc_setChemistry(soc_ChemistryType chemistry_e)
+{
+    if (chemistry_e < SOC_CHEMISTRY_COUNT)
+    {
+        perf_count(eepromWrites_ui16);
+        eeprom_update_byte(&soc_chemistryEeprom_ui8, (uint8)chemistry_e);
+        soc_init();
+    }
+}
+
+soc_ChemistryType soc_getChemistry(void)
+{
+    return soc_chemistry_e;
+}
+
+const soc_ProfileType *soc_getProfile(void)
+{
+    return &soc_profile_s;
+}
+
+uint8 soc_getPercent(uint16 cellMilliVolt_ui16)
+{
+    const soc_CurvePointType *points = soc_profile_s.points_ps;
+    uint8 low_ui8 = 0;
+    uint8 high_ui8 = soc_profile_s.numberOfPoints_ui8 - 1;
+    uint8 mid_ui8;
+
+    if (cellMilliVolt_ui16 <= soc_readMilliVolt(&points[low_ui8]))
+    {
+        return soc_readPercent(&points[low_ui8]);
+    }
+    if (cellMilliVolt_ui16 >= soc_readMilliVolt(&points[high_ui8]))
+    {
+        return soc_readPercent(&points[high_ui8]);
+    }
+
+    /* find the segment with points[low] <= voltage < points[high] */
+    while ((high_ui8 - low_ui8) > 1)
+    {
+        mid_ui8 = (uint8)((low_ui8 + high_ui8) >> 1);
+        if (cellMilliVolt_ui16 < soc_readMilliVolt(&points[mid_ui8]))
+        {
+            high_ui8 = mid_ui8;
+        }
+        else
+        {
+            low_ui8 = mid_ui8;
+        }
+    }
+
+    return (uint8)soc_interpolate(cellMilliVolt_ui16,
+                                  soc_readMilliVolt(&points[low_ui8]), soc_readMilliVolt(&points[high_ui8]),
+                                  soc_readPercent(&points[low_ui8]),   soc_readPercent(&points[high_ui8]));
+}
+
+uint16 soc_getCellMilliVolt(uint8 percent_ui8)
+{
+    const soc_CurvePointType *points = soc_profile_s.points_ps;
+    uint8 low_ui8 = 0;
+    uint8 high_ui8 = soc_profile_s.numberOfPoints_ui8 - 1;
+    uint8 mid_ui8;
+
+    if (percent_ui8 <= soc_readPercent(&points[low_ui8]))
+    {
+        return soc_readMilliVolt(&points[low_ui8]);
+    }
+    if (percent_ui8 >= soc_readPercent(&points[high_ui8]))
+    {
+        return soc_readMilliVolt(&points[high_ui8]);
+    }
+
+    while ((high_ui8 - low_ui8) > 1)
+    {
+        mid_ui8 = (uint8)((low_ui8 + high_ui8) >> 1);
+        if (percent_ui8 < soc_readPercent(&points[mid_ui8]))
+        {
+            high_ui8 = mid_ui8;
+        }
+        else
+        {
+            low_ui8 = mid_ui8;
+        }
+    }
+
+    return soc_interpolate(percent_ui8,
+                           soc_readPercent(&points[low_ui8]),   soc_readPercent(&points[high_ui8]),
+                           soc_readMilliVolt(&points[low_ui8]), soc_readMilliVolt(&points[high_ui8]));
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* y0 + (x - x0) * (y1 - y0) / (x1 - x0) for x0 <= x < x1 and rising y */
+static uint16 soc_interpolate(uint16 x_ui16, uint16 x0_ui16, uint16 x1_ui16, uint16 y0_ui16, uint16 y1_ui16)
+{
+    return (uint16)(y0_ui16 + (uint16)(((uint32)(x_ui16 - x0_ui16) * (y1_ui16 - y0_ui16)) / (x1_ui16 - x0_ui16)));
+}
+
+
+/* ************************************ E O F *************************************************** */
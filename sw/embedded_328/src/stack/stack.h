@@ -0,0 +1,67 @@
+/* *************************************************************************************************
+ * file:        stack.h
+ *
+ *          The stack module header, high-water mark of the stack and sram usage.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent stack_paint() called from main()
+ *
+ * notes:
+ *          stack_paint() fills the sram from the end of .bss up to the stack of main() with
+ *          STACK_PAINT. the stack grows down into it and leaves its values behind,
+ *          so the lowest byte that is no longer painted is the deepest the stack has been,
+ *          the interrupts included. there is no malloc(), the gap between .bss and that byte
+ *          is all the sram that is still free.
+ *
+ *          stack_getUsage() scans the free bytes from the end of .bss, about 5 cycles per
+ *          byte, some thousand cycles on an idle 328. call it seldom, not from an interrupt.
+ *
+ *          the worst case depth is not measured but bounded from the call graph of gcc,
+ *          "make stackcheck" in the tree of the target, see sw/tools/stackcheck.py.
+ *
+ *          the 328 reports the usage in its telemetry. the attiny84 has no output for it, the
+ *          painted sram is read over debugWIRE.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _STACK_H_
+#define _STACK_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define STACK_PAINT                 (0xC5U)
+
+/* bytes below the stack pointer of stack_paint() that are left alone, its own frame */
+#define STACK_PAINT_GUARD           (16U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    uint16  staticBytes_ui16;       // .data and .bss
+    uint16  stackMaxBytes_ui16;     // high-water mark since reset
+    uint16  freeBytes_ui16;         // never touched since reset
+}stack_UsageType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void stack_paint(void);
+void stack_getUsage(stack_UsageType *usage_ps);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _STACK_H_ */
@@ -0,0 +1,164 @@
+/* *************************************************************************************************
+ * file:        telemetry.c
+ *
+ *          The telemetry module, battery state for a flight controller over I2C.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent sram usage
+ *          19.10.2026  agent performance counters
+ *          19.10.2026  agent sram usage scanned once per second
+ *
+ * notes:
+ *          the values are written into the back buffer of the twi slave register file and
+ *          published at once, a bus read always sees one complete measurement. the sram
+ *          scan of stack/stack.h walks all free bytes, so it runs only every
+ *          TELEMETRY_USAGE_INTERVAL_MS and the updates in between repeat its result. the
+ *          performance counters are
+ *          copied at once, the record is consistent in itself.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <stddef.h>
+#include "telemetry.h"
+#include "../stack/stack.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define TELEMETRY_USAGE_INTERVAL_MS     (1000U)
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static uint8 telemetrySequence_ui8;
+static stack_UsageType telemetryUsage_s;
+static timer_TickType telemetryUsageTick_ui16;
+static boolean telemetryUsageValid_b = FALSE;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static void telemetry_put16(uint8 *registers_pui8, uint8 reg_ui8, uint16 value_ui16);
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+/* balance_ps may be NULL, then every cell is reported with the average cell voltage.
+ * returns E_NOT_OK if a bus read still holds the buffer, the values are dropped then.
+ */
+Std_ReturnType telemetry_update(uint16 packMilliVolt_ui16, uint8 cells_ui8, uint8 socPercent_ui8, const balance_ResultType *balance_ps)
+{
+    uint8 *registers_pui8 = twi_slaveGetRegisters();
+    perf_CountersType counters_s;
+    const perf_LoopTimeType *loopTime_ps = perf_getLoopTime();
+    uint16 averageMilliVolt_ui16 = 0;
+    uint8 flags_ui8 = 0;
+    uint8 cell_ui8;
+    uint8 channel_ui8;
+
+    if (registers_pui8 == NULL)
+    {
+        return E_NOT_OK;
+    }
+
+    if (cells_ui8 > BALANCE_MAX_CELLS)
+    {
+        cells_ui8 = 0;
+    }
+    if (cells_ui8 != 0)
+    {
+        flags_ui8 |= TELEMETRY_FLAG_CELLS_VALID;
+        averageMilliVolt_ui16 = packMilliVolt_ui16 / cells_ui8;
+        if (socPercent_ui8 < TELEMETRY_LOW_PERCENT)
+        {
+            flags_ui8 |= TELEMETRY_FLAG_LOW;
+        }
+    }
+    if (balance_ps != NULL)
+    {
+        flags_ui8 |= TELEMETRY_FLAG_BALANCE;
+    }
+
+    registers_pui8[TELEMETRY_REG_ID] = TELEMETRY_ID;
+    registers_pui8[TELEMETRY_REG_VERSION] = TELEMETRY_VERSION;
+    registers_pui8[TELEMETRY_REG_SEQUENCE] = ++telemetrySequence_ui8;
+    registers_pui8[TELEMETRY_REG_FLAGS] = flags_ui8;
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PACK_MV, packMilliVolt_ui16);
+    registers_pui8[TELEMETRY_REG_CELLS] = cells_ui8;
+    registers_pui8[TELEMETRY_REG_SOC] = socPercent_ui8;
+
+    if (balance_ps != NULL)
+    {
+        telemetry_put16(registers_pui8, TELEMETRY_REG_MIN_CELL_MV, balance_ps->minCellMilliVolt_ui16);
+        telemetry_put16(registers_pui8, TELEMETRY_REG_MAX_CELL_MV, balance_ps->maxCellMilliVolt_ui16);
+    }
+    else
+    {
+        telemetry_put16(registers_pui8, TELEMETRY_REG_MIN_CELL_MV, averageMilliVolt_ui16);
+        telemetry_put16(registers_pui8, TELEMETRY_REG_MAX_CELL_MV, averageMilliVolt_ui16);
+    }
+
+    for (cell_ui8 = 0; cell_ui8 < BALANCE_MAX_CELLS; cell_ui8++)
+    {
+        uint16 cellMilliVolt_ui16 = 0;
+
+        if (cell_ui8 < cells_ui8)
+        {
+            cellMilliVolt_ui16 = (balance_ps != NULL) ? balance_ps->cellMilliVolt_aui16[cell_ui8] : averageMilliVolt_ui16;
+        }
+        telemetry_put16(registers_pui8, (uint8)(TELEMETRY_REG_CELL_MV + 2U * cell_ui8), cellMilliVolt_ui16);
+    }
+
+    if ((telemetryUsageValid_b == FALSE) || (timer_elapsed(telemetryUsageTick_ui16) >= (TELEMETRY_USAGE_INTERVAL_MS / TIMER_TICK_MS)))
+    {
+        stack_getUsage(&telemetryUsage_s);
+        telemetryUsageTick_ui16 = timer_getTicks();
+        telemetryUsageValid_b = TRUE;
+    }
+    telemetry_put16(registers_pui8, TELEMETRY_REG_STATIC_BYTES, telemetryUsage_s.staticBytes_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_STACK_MAX_BYTES, telemetryUsage_s.stackMaxBytes_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_SRAM_FREE_BYTES, telemetryUsage_s.freeBytes_ui16);
+
+    perf_get(&counters_s);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_LOOPS, counters_s.loops_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_LOOP_MIN, loopTime_ps->min_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_LOOP_AVG, loopTime_ps->avg_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_LOOP_MAX, loopTime_ps->max_ui16);
+    for (channel_ui8 = 0; channel_ui8 < PERF_ADC_CHANNELS; channel_ui8++)
+    {
+        telemetry_put16(registers_pui8, (uint8)(TELEMETRY_REG_PERF_ADC + 2U * channel_ui8), counters_s.adcConversions_aui16[channel_ui8]);
+    }
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_ISR_UART_RX, counters_s.isrUartRx_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_ISR_UART_UDRE, counters_s.isrUartUdre_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_ISR_TWI, counters_s.isrTwi_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_ISR_ADC, counters_s.isrAdc_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_UART_TX_FULL, counters_s.uartTxFull_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_TWI_ERRORS, twi_getErrorCount());
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_TWI_NACKS, counters_s.twiNacks_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_EEPROM_WRITES, counters_s.eepromWrites_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_SLEEP_TICKS, counters_s.sleepTicks_ui16);
+    telemetry_put16(registers_pui8, TELEMETRY_REG_PERF_AWAKE_TICKS, (uint16)(timer_getTicks() - counters_s.sleepTicks_ui16));
+
+    twi_slavePublish();
+    return E_OK;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+static void telemetry_put16(uint8 *registers_pui8, uint8 reg_ui8, uint16 value_ui16)
+{
+    registers_pui8[reg_ui8] = (uint8)value_ui16;
+    registers_pui8[reg_ui8 + 1U] = (uint8)(value_ui16 >> 8);
+}
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,125 @@
+/* *************************************************************************************************
+ * file:        telemetry.h
+ *
+ *          The telemetry module header, battery state for a flight controller over I2C.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent version 2, sram usage
+ *          19.10.2026  agent version 3, performance counters
+ *
+ * notes:
+ *          the registers are read from the twi slave, write the register address first and
+ *          read on with a repeated start. 16 bit values are little endian. SEQUENCE counts
+ *          the updates, a master sees if the values are new.
+ *
+ *          addr  size  register
+ *          ----+-----+--------------------------------------------------------
+ *          0x00   1    ID, always TELEMETRY_ID
+ *          0x01   1    VERSION of this map
+ *          0x02   1    SEQUENCE
+ *          0x03   1    FLAGS
+ *          0x04   2    PACK_MV, pack voltage in mV
+ *          0x06   1    CELLS, 0 = unknown
+ *          0x07   1    SOC in %
+ *          0x08   2    MIN_CELL_MV
+ *          0x0A   2    MAX_CELL_MV
+ *          0x0C  12    CELL_MV[6], 0 for cells that are not there
+ *          0x18   2    STATIC_BYTES, sram used by .data and .bss
+ *          0x1A   2    STACK_MAX_BYTES, high-water mark of the stack since reset
+ *          0x1C   2    SRAM_FREE_BYTES, never touched since reset, see stack/stack.h
+ *
+ *          performance record, one block from PERF_LOOPS on, see perf/perf.h. the counters
+ *          wrap, compare the differences of two reads.
+ *          0x1E   2    PERF_LOOPS, main loop cycles
+ *          0x20   2    PERF_LOOP_MIN_TICKS, busy part of a cycle over PERF_LOOP_WINDOW cycles
+ *          0x22   2    PERF_LOOP_AVG_TICKS
+ *          0x24   2    PERF_LOOP_MAX_TICKS
+ *          0x26  16    PERF_ADC[8], conversions by adc channel
+ *          0x36   2    PERF_ISR_UART_RX
+ *          0x38   2    PERF_ISR_UART_UDRE
+ *          0x3A   2    PERF_ISR_TWI
+ *          0x3C   2    PERF_ISR_ADC
+ *          0x3E   2    PERF_UART_TX_FULL, bytes that waited for room in the transmit ring
+ *          0x40   2    PERF_TWI_ERRORS, timeouts, bus errors and recoveries
+ *          0x42   2    PERF_TWI_NACKS, polled transfers not acknowledged
+ *          0x44   2    PERF_EEPROM_WRITES
+ *          0x46   2    PERF_SLEEP_TICKS, ms asleep
+ *          0x48   2    PERF_AWAKE_TICKS, ms awake
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+#include "../balance/balance.h"
+#include "../twi/twi.h"
+#include "../perf/perf.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define TELEMETRY_ID                    (0x4CU)
+#define TELEMETRY_VERSION               (3U)
+
+#define TELEMETRY_REG_ID                (0x00U)
+#define TELEMETRY_REG_VERSION           (0x01U)
+#define TELEMETRY_REG_SEQUENCE          (0x02U)
+#define TELEMETRY_REG_FLAGS             (0x03U)
+#define TELEMETRY_REG_PACK_MV           (0x04U)
+#define TELEMETRY_REG_CELLS             (0x06U)
+#define TELEMETRY_REG_SOC               (0x07U)
+#define TELEMETRY_REG_MIN_CELL_MV       (0x08U)
+#define TELEMETRY_REG_MAX_CELL_MV       (0x0AU)
+#define TELEMETRY_REG_CELL_MV           (0x0CU)
+#define TELEMETRY_REG_STATIC_BYTES      (TELEMETRY_REG_CELL_MV + 2U * BALANCE_MAX_CELLS)
+#define TELEMETRY_REG_STACK_MAX_BYTES   (TELEMETRY_REG_STATIC_BYTES + 2U)
+#define TELEMETRY_REG_SRAM_FREE_BYTES   (TELEMETRY_REG_STACK_MAX_BYTES + 2U)
+#define TELEMETRY_REG_PERF_LOOPS        (TELEMETRY_REG_SRAM_FREE_BYTES + 2U)
+#define TELEMETRY_REG_PERF_LOOP_MIN     (TELEMETRY_REG_PERF_LOOPS + 2U)
+#define TELEMETRY_REG_PERF_LOOP_AVG     (TELEMETRY_REG_PERF_LOOP_MIN + 2U)
+#define TELEMETRY_REG_PERF_LOOP_MAX     (TELEMETRY_REG_PERF_LOOP_AVG + 2U)
+#define TELEMETRY_REG_PERF_ADC          (TELEMETRY_REG_PERF_LOOP_MAX + 2U)
+#define TELEMETRY_REG_PERF_ISR_UART_RX  (TELEMETRY_REG_PERF_ADC + 2U * PERF_ADC_CHANNELS)
+#define TELEMETRY_REG_PERF_ISR_UART_UDRE (TELEMETRY_REG_PERF_ISR_UART_RX + 2U)
+#define TELEMETRY_REG_PERF_ISR_TWI      (TELEMETRY_REG_PERF_ISR_UART_UDRE + 2U)
+#define TELEMETRY_REG_PERF_ISR_ADC      (TELEMETRY_REG_PERF_ISR_TWI + 2U)
+#define TELEMETRY_REG_PERF_UART_TX_FULL (TELEMETRY_REG_PERF_ISR_ADC + 2U)
+#define TELEMETRY_REG_PERF_TWI_ERRORS   (TELEMETRY_REG_PERF_UART_TX_FULL + 2U)
+#define TELEMETRY_REG_PERF_TWI_NACKS    (TELEMETRY_REG_PERF_TWI_ERRORS + 2U)
+#define TELEMETRY_REG_PERF_EEPROM_WRITES (TELEMETRY_REG_PERF_TWI_NACKS + 2U)
+#define TELEMETRY_REG_PERF_SLEEP_TICKS  (TELEMETRY_REG_PERF_EEPROM_WRITES + 2U)
+#define TELEMETRY_REG_PERF_AWAKE_TICKS  (TELEMETRY_REG_PERF_SLEEP_TICKS + 2U)
+#define TELEMETRY_REG_SIZE              (TELEMETRY_REG_PERF_AWAKE_TICKS + 2U)
+
+/* FLAGS */
+#define TELEMETRY_FLAG_CELLS_VALID      (1U << 0)   // cell count known
+#define TELEMETRY_FLAG_BALANCE          (1U << 1)   // cells measured on the balance lead
+#define TELEMETRY_FLAG_LOW              (1U << 2)   // soc below TELEMETRY_LOW_PERCENT
+
+#define TELEMETRY_LOW_PERCENT           (20U)
+
+#if (TWI_SLAVE_MODE != STD_ON) || (TELEMETRY_REG_SIZE > TWI_SLAVE_REGISTER_SIZE)
+#error "telemetry: needs TWI_SLAVE_MODE with at least TELEMETRY_REG_SIZE registers"
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+Std_ReturnType telemetry_update(uint16 packMilliVolt_ui16, uint8 cells_ui8, uint8 socPercent_ui8, const balance_ResultType *balance_ps);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _TELEMETRY_H_ */
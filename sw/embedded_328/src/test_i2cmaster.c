@@ -21,6 +21,7 @@ Description:
 int main(void)
 {
     unsigned char ret;
+    unsigned char page[4] = { 0x70, 0x71, 0x72, 0x74 };
     
 
     DDRB  = 0xff;                              // use all pins on port B for output 
@@ -54,10 +55,7 @@ int main(void)
            wait until the device is no longer busy from the previous write operation */
         i2c_start_wait(Dev24C02+I2C_WRITE);     // set device address and write mode
         i2c_write(0x00);                        // write start address = 0
-        i2c_write(0x70);                        // write data to address 0
-        i2c_write(0x71);                        //    "    "   "    "    1
-        i2c_write(0x72);                        //    "    "   "    "    2
-        i2c_write(0x74);                        //    "    "   "    "    3
+        i2c_writeBuffer(page, sizeof(page));    // write data to address 0..3
         i2c_stop();                             // set stop conditon = release bus
     
         /* write ok, read value back from eeprom address 0..3 (Sequencial Read),
@@ -65,13 +63,10 @@ int main(void)
         i2c_start_wait(Dev24C02+I2C_WRITE);      // set device address and write mode
         i2c_write(0x00);                         // write address = 0
         i2c_rep_start(Dev24C02+I2C_READ);        // set device address and read mode
-        ret = i2c_readAck();                       // read one byte form address 0
-        ret = i2c_readAck();                       //  "    "    "    "     "    1
-        ret = i2c_readAck();                       //  "    "    "    "     "    2
-        ret = i2c_readNak();                       //  "    "    "    "     "    3
+        i2c_readBuffer(page, sizeof(page));      // read address 0..3
         i2c_stop();                              // set stop condition = release bus
     
-        PORTB = ~ret;                            // output byte on the LED's        
+        PORTB = ~page[3];                        // output byte on the LED's        
     }
     
     for(;;);	
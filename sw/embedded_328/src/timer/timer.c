@@ -0,0 +1,130 @@
+/* *************************************************************************************************
+ * file:        timer.c
+ *
+ *          The system tick timer module.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent seconds since power on
+ *          19.10.2026  agent sub millisecond stamp for the trace
+ *          19.10.2026  agent performance counters
+ *
+ * notes:
+ *      bit7  bit6  bit5  bit4  bit3  bit2  bit1  bit0   register
+ *      -----+-----+-----+-----+-----+-----+-----+-----+---------+
+ *      COM0A1 COM0A0 COM0B1 COM0B0 –  –    WGM01 WGM00| TCCR0A
+ *      FOC0A FOC0B  –     –     WGM02 CS02 CS01  CS00 | TCCR0B
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "timer.h"
+#include "../perf/perf.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#if (TIMER_PRESCALER == 8UL)
+#define TIMER_CLOCK_SELECT      (1 << CS01)
+#elif (TIMER_PRESCALER == 64UL)
+#define TIMER_CLOCK_SELECT      ((1 << CS01) | (1 << CS00))
+#elif (TIMER_PRESCALER == 256UL)
+#define TIMER_CLOCK_SELECT      (1 << CS02)
+#else
+#error "timer: TIMER_PRESCALER must be 8, 64 or 256"
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static volatile timer_TickType timerTicks_ui16;
+static volatile uint32 timerSeconds_ui32;
+static uint16 timerMilliSeconds_ui16;           // milliseconds of the running second
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void timer_init(void)
+{
+    timerTicks_ui16 = 0;
+    timerSeconds_ui32 = 0;
+    timerMilliSeconds_ui16 = 0;
+    OCR0A = (uint8)TIMER_COMPARE_VALUE;
+    TCCR0A = (1 << WGM01);          // CTC, top = OCR0A
+    TCCR0B = TIMER_CLOCK_SELECT;
+    TIMSK0 = (1 << OCIE0A);
+}
+
+timer_TickType timer_getTicks(void)
+{
+    timer_TickType ticks;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        ticks = timerTicks_ui16;
+    }
+    return ticks;
+}
+
+timer_TickType timer_elapsed(timer_TickType since_ui16)
+{
+    return (timer_TickType)(timer_getTicks() - since_ui16);
+}
+
+uint32 timer_getSeconds(void)
+{
+    uint32 seconds;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        seconds = timerSeconds_ui32;
+    }
+    return seconds;
+}
+
+/* interrupts masked: a compare match that is not served yet shows as a small count */
+uint16 timer_getStamp(void)
+{
+    uint8 count_ui8 = TCNT0;
+    uint8 ticks_ui8 = (uint8)timerTicks_ui16;
+
+    if (((TIFR0 & (1 << OCF0A)) != 0U) && (count_ui8 < (uint8)(TIMER_COMPARE_VALUE / 2UL)))
+    {
+        ticks_ui8++;
+    }
+    return (uint16)(((uint16)ticks_ui8 << 8) | count_ui8);
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+
+/* ------------------------------------ INTERRUPT SERVICE ROUTINES ------------------------------ */
+
+ISR(TIMER0_COMPA_vect)
+{
+    timerTicks_ui16 += TIMER_TICK_MS;
+    perf_tick();
+
+    timerMilliSeconds_ui16 += TIMER_TICK_MS;
+    if (timerMilliSeconds_ui16 >= 1000U)
+    {
+        timerMilliSeconds_ui16 = 0;
+        timerSeconds_ui32++;
+    }
+}
+
+/* ************************************ E O F *************************************************** */
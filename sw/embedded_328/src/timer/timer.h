@@ -0,0 +1,61 @@
+/* *************************************************************************************************
+ * file:        timer.h
+ *
+ *          The system tick timer module header.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent seconds since power on
+ *          19.10.2026  agent sub millisecond stamp for the trace
+ *
+ * notes:
+ *          timer0 runs in CTC mode and counts milliseconds. the counter wraps after 65s,
+ *          so only differences of ticks are meaningful, use timer_elapsed() for deadlines.
+ *          timer_getSeconds() counts the seconds since power on and does not wrap in practice.
+ *          timer_getStamp() is the low byte of the ticks and the count of timer0 in one word,
+ *          only for the trace, it must be called with the interrupts masked.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _TIMER_H_
+#define _TIMER_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include <avr/io.h>
+#include "../../inc/std_types.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define TIMER_TICK_MS           (1U)
+#define TIMER_PRESCALER         (64UL)
+#define TIMER_COMPARE_VALUE     ((F_CPU / TIMER_PRESCALER / (1000UL / TIMER_TICK_MS)) - 1UL)
+
+#if (TIMER_COMPARE_VALUE > 255UL) || (TIMER_COMPARE_VALUE < 10UL)
+#error "timer: TIMER_PRESCALER does not fit F_CPU"
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef uint16 timer_TickType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void timer_init(void);
+timer_TickType timer_getTicks(void);
+timer_TickType timer_elapsed(timer_TickType since_ui16);
+uint32 timer_getSeconds(void);
+uint16 timer_getStamp(void);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _TIMER_H_ */
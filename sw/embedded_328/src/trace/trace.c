@@ -0,0 +1,93 @@
+/* *************************************************************************************************
+ * file:        trace.c
+ *
+ *          The trace module, timestamped events in a ram ring.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          trace_event() may be called from the interrupts, the entry is written with the
+ *          interrupts masked for about 30 cycles. a filtered event costs the call and a shift.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "trace.h"
+#include "../timer/timer.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define TRACE_MASK                  (TRACE_SIZE - 1U)
+
+#if ((TRACE_SIZE & TRACE_MASK) != 0U) || ((TRACE_SIZE * 5U + 2U) > 255U)
+#error "trace: TRACE_SIZE must be a power of 2 that fits into one dump frame"
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static trace_RingType trace_ring_s;
+static volatile uint8 trace_mask_ui8 = TRACE_DEFAULT_MASK;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void trace_event(trace_EventType event_e, uint16 payload_ui16)
+{
+    trace_EntryType *entry_ps;
+    uint8 sreg_ui8;
+
+    if (((trace_mask_ui8 >> trace_group(event_e)) & 0x01U) == 0U)
+    {
+        return;
+    }
+
+    sreg_ui8 = SREG;
+    cli();
+    entry_ps = &trace_ring_s.entries_as[trace_ring_s.head_ui8];
+    entry_ps->event_ui8 = (uint8)event_e;
+    entry_ps->stamp_ui16 = timer_getStamp();
+    entry_ps->payload_ui16 = payload_ui16;
+    trace_ring_s.head_ui8 = (uint8)((trace_ring_s.head_ui8 + 1U) & TRACE_MASK);
+    if (trace_ring_s.count_ui8 < TRACE_SIZE)
+    {
+        trace_ring_s.count_ui8++;
+    }
+    SREG = sreg_ui8;
+}
+
+/* returns the mask before, 0 stops the recording */
+uint8 trace_setMask(uint8 mask_ui8)
+{
+    uint8 old_ui8 = trace_mask_ui8;
+
+    trace_mask_ui8 = (uint8)(mask_ui8 & TRACE_GROUP_ALL);
+    return old_ui8;
+}
+
+/* stop the recording while the ring is read */
+const trace_RingType *trace_get(void)
+{
+    return &trace_ring_s;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+
+/* ************************************ E O F *************************************************** */
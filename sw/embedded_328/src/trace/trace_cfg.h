@@ -0,0 +1,36 @@
+/* *************************************************************************************************
+ * file:        trace_cfg.h
+ *
+ *          The trace module configuration of the ATmega328 board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _TRACE_CFG_H_
+#define _TRACE_CFG_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define TRACE_MODE                  STD_ON
+
+/* entries of 5 bytes, a power of 2, the whole ring goes into one dump frame */
+#define TRACE_SIZE                  (32U)
+
+/* groups recorded after reset, the command "trace" changes them */
+#define TRACE_DEFAULT_MASK          (TRACE_GROUP_ADC | TRACE_GROUP_LED | TRACE_GROUP_SCHEDULER)
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _TRACE_CFG_H_ */
@@ -0,0 +1,519 @@
+/* *************************************************************************************************
+ * file:        twi.c
+ *
+ *          The interrupt driven twi master module.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent timeouts, bus recovery and error counter
+ *          19.10.2026  agent selectable fast mode, bit rate computed from F_CPU
+ *          19.10.2026  agent slave register file
+ *          19.10.2026  agent trace points
+ *          19.10.2026  agent performance counters
+ *          19.10.2026  agent a slave transaction times out after TWI_SLAVE_TIMEOUT_MS
+ *
+ * notes:
+ *          every bus event raises TWI_vect, the state machine below reacts on the status
+ *          code and hands the next byte to the hardware. between the events the cpu is free.
+ *          a finished transaction is completed with a stop condition, the next queued one
+ *          starts right after it with a combined stop and start.
+ *
+ *          in slave mode the own address is acknowledged whenever the master side is idle.
+ *          a master write sets the register pointer, a master read gets the registers from
+ *          the pointer on. a read latches the front buffer for its whole duration, so the
+ *          application can fill the back buffer without tearing a multi byte value.
+ *          a queued master transaction waits until the slave transaction has finished.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <stddef.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+#include <util/delay.h>
+#include <compat/twi.h>
+#include "twi.h"
+#include "../trace/trace.h"
+#include "../perf/perf.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define TWI_CONTINUE        ((1 << TWINT) | (1 << TWEN) | (1 << TWIE))
+#define TWI_CONTINUE_ACK    (TWI_CONTINUE | (1 << TWEA))
+#define TWI_RELEASE         (TWI_CONTINUE | TWI_IDLE_BITS)
+#define TWI_START           (TWI_RELEASE | (1 << TWSTA))
+#define TWI_STOP            ((1 << TWINT) | (1 << TWEN) | (1 << TWSTO) | TWI_IDLE_BITS)
+#define TWI_STOP_START      (TWI_START | (1 << TWSTO))
+
+#define TWI_SLAVE_NO_BUFFER (0xFFU)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static twi_TransactionType * volatile twiQueue_aps[TWI_QUEUE_SIZE];
+static volatile uint8 twiQueueHead_ui8;         // next transaction to run
+static volatile uint8 twiQueueCount_ui8;        // including the running one
+
+static uint8 twiIndex_ui8;                      // byte index inside the current phase
+static boolean twiReadPhase_b;
+static timer_TickType twiEventTick_ui16;        // time of the last bus event
+static uint16 twiErrors_ui16;
+static volatile boolean twiSlaveActive_b;       // addressed as slave right now
+
+#if (TWI_SLAVE_MODE == STD_ON)
+static uint8 twiSlaveRegisters_aa[2][TWI_SLAVE_REGISTER_SIZE];
+static volatile uint8 twiSlaveFront_ui8;        // buffer the bus reads from
+static volatile uint8 twiSlaveLatched_ui8;      // buffer of a running read
+static uint8 twiSlavePointer_ui8;
+static boolean twiSlavePointerSet_b;
+#endif
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static void twi_begin(void);
+static boolean twi_complete(twi_StatusType status_e);
+static void twi_finish(twi_StatusType status_e);
+#if (TWI_SLAVE_MODE == STD_ON)
+static void twi_slaveEnd(void);
+#endif
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void twi_init(void)
+{
+    /* range checked in twi.h, TWBR must be >= 10 for stable operation */
+    TWSR = TWI_TWPS_VALUE;
+    TWBR = (uint8)TWI_TWBR_VALUE;
+
+    twiQueueHead_ui8 = 0;
+    twiQueueCount_ui8 = 0;
+    twiSlaveActive_b = FALSE;
+
+#if (TWI_SLAVE_MODE == STD_ON)
+    twiSlaveFront_ui8 = 0;
+    twiSlaveLatched_ui8 = TWI_SLAVE_NO_BUFFER;
+    twiSlavePointer_ui8 = 0;
+    TWAR = (uint8)(TWI_SLAVE_ADDRESS << 1);     // no general call
+#endif
+
+    TWCR = (1 << TWEN) | TWI_IDLE_BITS;
+}
+
+Std_ReturnType twi_submit(twi_TransactionType *transaction_ps)
+{
+    Std_ReturnType result = E_NOT_OK;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (twiQueueCount_ui8 < TWI_QUEUE_SIZE)
+        {
+            transaction_ps->status_e = TWI_STATUS_PENDING;
+            twiQueue_aps[(uint8)(twiQueueHead_ui8 + twiQueueCount_ui8) % TWI_QUEUE_SIZE] = transaction_ps;
+            twiQueueCount_ui8++;
+
+            /* the bus was idle, kick off this transaction. a running slave transaction
+             * starts it when it is finished.
+             */
+            if ((twiQueueCount_ui8 == 1) && (twiSlaveActive_b == FALSE))
+            {
+                twi_begin();
+                TWCR = TWI_START;
+            }
+            result = E_OK;
+        }
+    }
+
+    return result;
+}
+
+twi_StatusType twi_transfer(twi_TransactionType *transaction_ps)
+{
+    transaction_ps->callback_pf = NULL;
+    while (twi_submit(transaction_ps) != E_OK)
+    {
+        twi_waitIdle();
+    }
+
+    /* sleep until the interrupt has finished the transaction. sei() delays the interrupt
+     * by one instruction, so the wake up cannot be lost between the check and sleep_cpu().
+     * the timer tick wakes the cpu up at least every millisecond to check the deadline.
+     */
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    cli();
+    while ((transaction_ps->status_e == TWI_STATUS_PENDING) || (transaction_ps->status_e == TWI_STATUS_BUSY))
+    {
+        twi_checkTimeout();
+        sleep_enable();
+        perf_sleepBegin();
+        sei();
+        sleep_cpu();
+        perf_sleepEnd();
+        sleep_disable();
+        cli();
+    }
+    sei();
+
+    return transaction_ps->status_e;
+}
+
+boolean twi_isIdle(void)
+{
+    return (boolean)((twiQueueCount_ui8 == 0) && (twiSlaveActive_b == FALSE));
+}
+
+void twi_waitIdle(void)
+{
+    timer_TickType start_ui16;
+
+    while (twi_isIdle() == FALSE)
+    {
+        twi_checkTimeout();
+    }
+
+    /* the last stop condition may still be on the bus */
+    start_ui16 = timer_getTicks();
+    while (TWCR & (1 << TWSTO))
+    {
+        if (timer_elapsed(start_ui16) > TWI_TIMEOUT_MS)
+        {
+            twi_recoverBus();
+        }
+    }
+}
+
+void twi_checkTimeout(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        timer_TickType timeout_ui16 = (twiSlaveActive_b == TRUE) ? TWI_SLAVE_TIMEOUT_MS : TWI_TIMEOUT_MS;
+
+        if ((twi_isIdle() == FALSE) && (timer_elapsed(twiEventTick_ui16) > timeout_ui16))
+        {
+            if (twiSlaveActive_b == TRUE)
+            {
+                /* the master vanished, forget the slave transaction but leave the bus alone */
+                twiErrors_ui16++;
+                TWCR = 0;
+                TWCR = (1 << TWEN) | TWI_IDLE_BITS;
+                twiSlaveActive_b = FALSE;
+#if (TWI_SLAVE_MODE == STD_ON)
+                twiSlaveLatched_ui8 = TWI_SLAVE_NO_BUFFER;
+#endif
+                if (twiQueueCount_ui8 != 0)
+                {
+                    twi_begin();
+                    TWCR = TWI_START;
+                }
+            }
+            else
+            {
+                twi_recoverBus();
+                if (twi_complete(TWI_STATUS_TIMEOUT) == TRUE)
+                {
+                    twi_begin();
+                    TWCR = TWI_START;
+                }
+            }
+        }
+    }
+}
+
+/* a slave that lost clocks in the middle of a byte holds SDA low forever. clocking SCL
+ * until it lets go of SDA and sending a stop brings it back, see the I2C spec 3.1.16.
+ */
+void twi_recoverBus(void)
+{
+    uint8 clock_ui8;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        twiErrors_ui16++;
+    }
+
+    /* hand the pins to the port, open drain emulated by the direction bits */
+    TWCR = 0;
+    TWI_PORT &= (uint8)~((1 << TWI_SDA_PIN) | (1 << TWI_SCL_PIN));
+    TWI_DDR &= (uint8)~((1 << TWI_SDA_PIN) | (1 << TWI_SCL_PIN));
+    _delay_us(5);
+
+    for (clock_ui8 = 0; (clock_ui8 < 9) && !(TWI_PIN & (1 << TWI_SDA_PIN)); clock_ui8++)
+    {
+        TWI_DDR |= (1 << TWI_SCL_PIN);
+        _delay_us(5);
+        TWI_DDR &= (uint8)~(1 << TWI_SCL_PIN);
+        _delay_us(5);
+    }
+
+    /* start followed by stop, SDA rises while SCL is high */
+    TWI_DDR |= (1 << TWI_SDA_PIN);
+    _delay_us(5);
+    TWI_DDR &= (uint8)~(1 << TWI_SDA_PIN);
+    _delay_us(5);
+
+    TWCR = (1 << TWEN) | TWI_IDLE_BITS;
+}
+
+uint16 twi_getErrorCount(void)
+{
+    uint16 errors_ui16;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        errors_ui16 = twiErrors_ui16;
+    }
+    return errors_ui16;
+}
+
+#if (TWI_SLAVE_MODE == STD_ON)
+/* returns the back buffer of the register file, NULL if a slow bus read still uses it */
+uint8 *twi_slaveGetRegisters(void)
+{
+    uint8 *registers_pui8 = NULL;
+    uint8 back_ui8 = twiSlaveFront_ui8 ^ 1U;
+
+    if (twiSlaveLatched_ui8 != back_ui8)
+    {
+        registers_pui8 = twiSlaveRegisters_aa[back_ui8];
+    }
+    return registers_pui8;
+}
+
+/* makes the back buffer the one the bus reads from */
+void twi_slavePublish(void)
+{
+    twiSlaveFront_ui8 ^= 1U;
+}
+#endif
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* marks the head of the queue as running. interrupts must be disabled. */
+static void twi_begin(void)
+{
+    twiIndex_ui8 = 0;
+    twiReadPhase_b = FALSE;
+    twiEventTick_ui16 = timer_getTicks();
+    twiQueue_aps[twiQueueHead_ui8]->status_e = TWI_STATUS_BUSY;
+}
+
+/* removes the running transaction from the queue, returns TRUE if another one is waiting.
+ * interrupts must be disabled.
+ */
+static boolean twi_complete(twi_StatusType status_e)
+{
+    twi_TransactionType *transaction_ps = twiQueue_aps[twiQueueHead_ui8];
+
+    twiQueueHead_ui8 = (uint8)(twiQueueHead_ui8 + 1) % TWI_QUEUE_SIZE;
+    twiQueueCount_ui8--;
+
+    transaction_ps->status_e = status_e;
+    if (transaction_ps->callback_pf != NULL)
+    {
+        transaction_ps->callback_pf(transaction_ps);
+    }
+
+    return (boolean)(twiQueueCount_ui8 != 0);
+}
+
+/* completes the running transaction and starts the next one. interrupt context only. */
+static void twi_finish(twi_StatusType status_e)
+{
+    if (twi_complete(status_e) == TRUE)
+    {
+        twi_begin();
+        TWCR = TWI_STOP_START;
+    }
+    else
+    {
+        TWCR = TWI_STOP;
+    }
+}
+
+#if (TWI_SLAVE_MODE == STD_ON)
+/* the master is done with us, start a waiting master transaction. interrupt context only. */
+static void twi_slaveEnd(void)
+{
+    twiSlaveActive_b = FALSE;
+    twiSlaveLatched_ui8 = TWI_SLAVE_NO_BUFFER;
+
+    if (twiQueueCount_ui8 != 0)
+    {
+        twi_begin();
+        TWCR = TWI_START;       // goes out as soon as the bus is free
+    }
+    else
+    {
+        TWCR = TWI_RELEASE;
+    }
+}
+#endif
+
+
+/* ------------------------------------ INTERRUPT SERVICE ROUTINES ------------------------------ */
+
+ISR(TWI_vect)
+{
+    twi_TransactionType *transaction_ps = twiQueue_aps[twiQueueHead_ui8];
+
+    trace_event(TRACE_ISR_ENTRY, TRACE_ISR_TWI);
+    perf_count(isrTwi_ui16);
+    twiEventTick_ui16 = timer_getTicks();
+
+    switch (TW_STATUS)
+    {
+    /* ---------------- master ---------------- */
+    case TW_START:
+    case TW_REP_START:
+        if ((twiReadPhase_b == FALSE) && ((transaction_ps->writeLength_ui8 != 0) || (transaction_ps->readLength_ui8 == 0)))
+        {
+            TWDR = transaction_ps->address_ui8 | TW_WRITE;
+        }
+        else
+        {
+            twiReadPhase_b = TRUE;
+            TWDR = transaction_ps->address_ui8 | TW_READ;
+        }
+        TWCR = TWI_CONTINUE;
+        break;
+
+    case TW_MT_SLA_ACK:
+    case TW_MT_DATA_ACK:
+        if (twiIndex_ui8 < transaction_ps->writeLength_ui8)
+        {
+            TWDR = transaction_ps->writeData_pui8[twiIndex_ui8++];
+            TWCR = TWI_CONTINUE;
+        }
+        else if (transaction_ps->readLength_ui8 != 0)
+        {
+            /* write phase done, repeated start for the read phase */
+            twiIndex_ui8 = 0;
+            twiReadPhase_b = TRUE;
+            TWCR = TWI_START;
+        }
+        else
+        {
+            twi_finish(TWI_STATUS_OK);
+        }
+        break;
+
+    case TW_MR_SLA_ACK:
+        /* acknowledge every byte but the last one */
+        TWCR = (transaction_ps->readLength_ui8 > 1) ? TWI_CONTINUE_ACK : TWI_CONTINUE;
+        break;
+
+    case TW_MR_DATA_ACK:
+        transaction_ps->readData_pui8[twiIndex_ui8++] = TWDR;
+        TWCR = ((uint8)(twiIndex_ui8 + 1) < transaction_ps->readLength_ui8) ? TWI_CONTINUE_ACK : TWI_CONTINUE;
+        break;
+
+    case TW_MR_DATA_NACK:
+        transaction_ps->readData_pui8[twiIndex_ui8++] = TWDR;
+        twi_finish(TWI_STATUS_OK);
+        break;
+
+    case TW_MT_SLA_NACK:
+    case TW_MR_SLA_NACK:
+    case TW_MT_DATA_NACK:
+        twi_finish(TWI_STATUS_NACK);
+        break;
+
+    case TW_MT_ARB_LOST:
+        /* another master won, leave the bus to it and retry the next one when it is free */
+        twiErrors_ui16++;
+        if (twi_complete(TWI_STATUS_ARBITRATION_LOST) == TRUE)
+        {
+            twi_begin();
+            TWCR = TWI_START;
+        }
+        else
+        {
+            TWCR = TWI_RELEASE;
+        }
+        break;
+
+#if (TWI_SLAVE_MODE == STD_ON)
+    /* ---------------- slave receiver, sets the register pointer ---------------- */
+    case TW_SR_ARB_LOST_SLA_ACK:
+        twiErrors_ui16++;
+        (void)twi_complete(TWI_STATUS_ARBITRATION_LOST);
+        /* falls through */
+    case TW_SR_SLA_ACK:
+        twiSlaveActive_b = TRUE;
+        twiSlavePointerSet_b = FALSE;
+        TWCR = TWI_CONTINUE_ACK;
+        break;
+
+    case TW_SR_DATA_ACK:
+        /* the register file is read only, further bytes are ignored */
+        if (twiSlavePointerSet_b == FALSE)
+        {
+            twiSlavePointer_ui8 = TWDR;
+            twiSlavePointerSet_b = TRUE;
+        }
+        TWCR = TWI_CONTINUE_ACK;
+        break;
+
+    case TW_SR_DATA_NACK:
+    case TW_SR_STOP:
+        /* stop or repeated start, a repeated start comes back as TW_ST_SLA_ACK */
+        twi_slaveEnd();
+        break;
+
+    /* ---------------- slave transmitter, sends the registers ---------------- */
+    case TW_ST_ARB_LOST_SLA_ACK:
+        twiErrors_ui16++;
+        (void)twi_complete(TWI_STATUS_ARBITRATION_LOST);
+        /* falls through */
+    case TW_ST_SLA_ACK:
+        twiSlaveActive_b = TRUE;
+        twiSlaveLatched_ui8 = twiSlaveFront_ui8;
+        /* falls through */
+    case TW_ST_DATA_ACK:
+        if (twiSlavePointer_ui8 < TWI_SLAVE_REGISTER_SIZE)
+        {
+            TWDR = twiSlaveRegisters_aa[twiSlaveLatched_ui8][twiSlavePointer_ui8++];
+        }
+        else
+        {
+            TWDR = 0xFF;
+        }
+        TWCR = TWI_CONTINUE_ACK;
+        break;
+
+    case TW_ST_DATA_NACK:
+    case TW_ST_LAST_DATA:
+        twi_slaveEnd();
+        break;
+#endif
+
+    default:
+        /* bus error or unexpected state, the stop resets the hardware */
+        twiErrors_ui16++;
+        twiSlaveActive_b = FALSE;
+        if (twiQueueCount_ui8 != 0)
+        {
+            twi_finish(TWI_STATUS_BUS_ERROR);
+        }
+        else
+        {
+            TWCR = TWI_STOP;
+        }
+        break;
+    }
+    trace_event(TRACE_ISR_EXIT, TRACE_ISR_TWI);
+}
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,165 @@
+/* *************************************************************************************************
+ * file:        twi.h
+ *
+ *          The interrupt driven twi master module header.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent timeouts, bus recovery and error counter
+ *          19.10.2026  agent selectable fast mode, bit rate computed from F_CPU
+ *          19.10.2026  agent slave register file
+ *          19.10.2026  agent register file sized for the sram usage of the telemetry
+ *          19.10.2026  agent register file sized for the performance record
+ *          19.10.2026  agent own timeout for the slave, checked from the main loop
+ *
+ * notes:
+ *          a transaction writes writeLength bytes and then, after a repeated start, reads
+ *          readLength bytes. both lengths may be 0, a transaction without data only probes
+ *          the address. transactions are queued and run from TWI_vect one after another.
+ *          the descriptor is owned by the caller and must stay valid until it is finished.
+ *
+ *          the blocking i2c_* functions of twimaster.c wait until the queue is empty and
+ *          must not be interleaved with twi_submit() while a transfer is open.
+ *
+ *          no wait is unbounded: a bus event that does not come within TWI_TIMEOUT_MS ends
+ *          the transaction with TWI_STATUS_TIMEOUT and clocks a stuck slave free. ack polling
+ *          gives up after TWI_BUSY_TIMEOUT_MS. the deadlines need the timer tick, so the
+ *          interrupts must be enabled. whoever uses twi_submit() without waiting for the
+ *          result has to call twi_checkTimeout() now and then.
+ *
+ *          as slave the pace is the one of the remote master, which may stretch a pause
+ *          between two bytes as far as SMBus allows (25ms to 35ms clock low). a slave
+ *          transaction is only dropped after TWI_SLAVE_TIMEOUT_MS without an event, the main
+ *          loop calls twi_checkTimeout() once per cycle for it.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _TWI_H_
+#define _TWI_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include <avr/io.h>
+#include "../../inc/std_types.h"
+#include "../timer/timer.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* STD_ON: 400kHz fast mode, all devices on the bus must support it */
+#define TWI_FAST_MODE           STD_OFF
+
+/* I2C clock in Hz */
+#if (TWI_FAST_MODE == STD_ON)
+#define TWI_SCL_CLOCK           (400000UL)
+#else
+#define TWI_SCL_CLOCK           (100000UL)
+#endif
+
+/* SCL = F_CPU / (16 + 2 * TWBR * 4^TWPS), the smallest prescaler that fits is taken */
+#define TWI_BITRATE(prescaler)  (((F_CPU / TWI_SCL_CLOCK) - 16UL) / (2UL * (prescaler)))
+
+#if ((F_CPU / TWI_SCL_CLOCK) < 36UL)
+#error "twi: F_CPU too low for TWI_SCL_CLOCK, TWBR must be at least 10"
+#elif (TWI_BITRATE(1UL) <= 255UL)
+#define TWI_TWPS_VALUE          (0U)
+#define TWI_TWBR_VALUE          TWI_BITRATE(1UL)
+#elif (TWI_BITRATE(4UL) <= 255UL)
+#define TWI_TWPS_VALUE          (1U)
+#define TWI_TWBR_VALUE          TWI_BITRATE(4UL)
+#elif (TWI_BITRATE(16UL) <= 255UL)
+#define TWI_TWPS_VALUE          (2U)
+#define TWI_TWBR_VALUE          TWI_BITRATE(16UL)
+#elif (TWI_BITRATE(64UL) <= 255UL)
+#define TWI_TWPS_VALUE          (3U)
+#define TWI_TWBR_VALUE          TWI_BITRATE(64UL)
+#else
+#error "twi: TWI_SCL_CLOCK too low for F_CPU"
+#endif
+
+/* longest gap between two bus events, a byte takes 0.1ms at 100kHz */
+#define TWI_TIMEOUT_MS          (2U)
+
+/* longest gap between two bus events as slave, above the 35ms a SMBus master may pause */
+#define TWI_SLAVE_TIMEOUT_MS    (40U)
+
+/* longest time a device may be busy, e.g. the write cycle of an eeprom */
+#define TWI_BUSY_TIMEOUT_MS     (10U)
+
+/* bus pins, needed for the recovery */
+#define TWI_PORT                PORTC
+#define TWI_DDR                 DDRC
+#define TWI_PIN                 PINC
+#define TWI_SDA_PIN             PC4
+#define TWI_SCL_PIN             PC5
+
+/* number of transactions that can wait in the queue */
+#define TWI_QUEUE_SIZE          (4U)
+
+/* STD_ON: answer as slave on TWI_SLAVE_ADDRESS (7 bit) with a read only register file */
+#define TWI_SLAVE_MODE          STD_ON
+#define TWI_SLAVE_ADDRESS       (0x42U)
+#define TWI_SLAVE_REGISTER_SIZE (74U)
+
+/* TWCR bits that stay set while the master side is idle */
+#if (TWI_SLAVE_MODE == STD_ON)
+#define TWI_IDLE_BITS           ((1 << TWIE) | (1 << TWEA))
+#else
+#define TWI_IDLE_BITS           (0U)
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef enum
+{
+    TWI_STATUS_OK = 0U,
+    TWI_STATUS_PENDING,             // queued, not started yet
+    TWI_STATUS_BUSY,                // on the bus
+    TWI_STATUS_NACK,                // address or data not acknowledged
+    TWI_STATUS_ARBITRATION_LOST,
+    TWI_STATUS_BUS_ERROR,
+    TWI_STATUS_TIMEOUT
+}twi_StatusType;
+
+typedef struct twi_TransactionStruct twi_TransactionType;
+
+/* called from the interrupt when a transaction is finished, keep it short */
+typedef void (*twi_CallbackType)(twi_TransactionType *transaction_ps);
+
+struct twi_TransactionStruct
+{
+    uint8                       address_ui8;        // device address as for i2c_start(), bit 0 = 0
+    const uint8                *writeData_pui8;
+    uint8                       writeLength_ui8;
+    uint8                      *readData_pui8;
+    uint8                       readLength_ui8;
+    twi_CallbackType            callback_pf;        // may be NULL
+    volatile twi_StatusType     status_e;
+};
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void twi_init(void);
+Std_ReturnType twi_submit(twi_TransactionType *transaction_ps);
+twi_StatusType twi_transfer(twi_TransactionType *transaction_ps);
+boolean twi_isIdle(void);
+void twi_waitIdle(void);
+void twi_checkTimeout(void);
+void twi_recoverBus(void);
+uint16 twi_getErrorCount(void);
+#if (TWI_SLAVE_MODE == STD_ON)
+uint8 *twi_slaveGetRegisters(void);
+void twi_slavePublish(void);
+#endif
+
+/* ************************************ E O F *************************************************** */
+#endif /* _TWI_H_ */
@@ -10,6 +10,8 @@
 #include <compat/twi.h>
 
 #include "twimaster.h"
+#include "twi.h"
+#include "../perf/perf.h"
 #include "../../inc/std_types.h"
 #include "../gpio/gpio.h"
 #include <util/delay.h>
@@ -20,19 +22,55 @@
 //#define F_CPU 7372800UL
 //#endif
 
-/* I2C clock in Hz */
-#define SCL_CLOCK  100000L
+
+/*************************************************************************
+ Waits until the hardware has finished the current bus event. A bus that
+ does not move within TWI_TIMEOUT_MS is recovered.
+
+ Return:  0 event finished
+          1 timeout
+*************************************************************************/
+static unsigned char i2c_wait(void)
+{
+    timer_TickType start = timer_getTicks();
+
+	while(!(TWCR & (1<<TWINT)))
+	{
+		if (timer_elapsed(start) > TWI_TIMEOUT_MS)
+		{
+			twi_recoverBus();
+			return 1;
+		}
+	}
+	return 0;
+
+}/* i2c_wait */
 
 
+/*************************************************************************
+ Waits until the stop condition is executed and the bus released
+*************************************************************************/
+static void i2c_waitStop(void)
+{
+    timer_TickType start = timer_getTicks();
+
+	while(TWCR & (1<<TWSTO))
+	{
+		if (timer_elapsed(start) > TWI_TIMEOUT_MS)
+		{
+			twi_recoverBus();
+		}
+	}
+
+}/* i2c_waitStop */
+
 /*************************************************************************
  Initialization of the I2C bus interface. Need to be called only once
 *************************************************************************/
 void i2c_init(void)
 {
-  /* initialize TWI clock: 100 kHz clock, TWPS = 0 => prescaler = 1 */
-  
-  TWSR = 0;                         /* no prescaler */
-  TWBR = ((F_CPU/SCL_CLOCK)-16)/2;  /* must be > 10 for stable operation */
+  /* the bit rate is set up by the interrupt driven twi module */
+  twi_init();
 
 }/* i2c_init */
 
@@ -45,10 +83,13 @@ unsigned char i2c_start(unsigned char address)
 {
     uint8_t   twst;
 
+	// the polled functions need the bus for themselves
+	twi_waitIdle();
+
 	// send START condition
 	TWCR = (1<<TWINT) | (1<<TWSTA) | (1<<TWEN);
 	// wait until transmission completed
-	while(!(TWCR & (1<<TWINT)));
+	if (i2c_wait()) return 1;
 	// check value of TWI Status Register. Mask prescaler bits.
 	twst = TW_STATUS & 0xF8;
 	if ( (twst != TW_START) && (twst != TW_REP_START)) return 1;
@@ -58,11 +99,15 @@ unsigned char i2c_start(unsigned char address)
 	TWCR = (1<<TWINT) | (1<<TWEN);
 
 	// wail until transmission completed and ACK/NACK has been received
-	while(!(TWCR & (1<<TWINT)));
+	if (i2c_wait()) return 1;
 
 	// check value of TWI Status Register. Mask prescaler bits.
 	twst = TW_STATUS & 0xF8;
-	if ( (twst != TW_MT_SLA_ACK) && (twst != TW_MR_SLA_ACK) ) return 1;
+	if ( (twst != TW_MT_SLA_ACK) && (twst != TW_MR_SLA_ACK) )
+	{
+		perf_count(twiNacks_ui16);
+		return 1;
+	}
 
 	return 0;
 
@@ -71,22 +116,35 @@ unsigned char i2c_start(unsigned char address)
 
 /*************************************************************************
  Issues a start condition and sends address and transfer direction.
- If device is busy, use ack polling to wait until device is ready
- 
+ If device is busy, use ack polling to wait until device is ready,
+ at most TWI_BUSY_TIMEOUT_MS.
+
  Input:   address and transfer direction of I2C device
+
+ Return:  0 device accessible
+          1 device still busy or bus error
 *************************************************************************/
-void i2c_start_wait(unsigned char address)
+unsigned char i2c_start_wait(unsigned char address)
 {
     uint8_t   twst;
+    timer_TickType start;
 
+    twi_waitIdle();
+    start = timer_getTicks();
 
     while ( 1 )
     {
+    	if (timer_elapsed(start) > TWI_BUSY_TIMEOUT_MS)
+    	{
+    	    perf_count(twiNacks_ui16);
+    	    return 1;
+    	}
+
 	    // send START condition
 	    TWCR = (1<<TWINT) | (1<<TWSTA) | (1<<TWEN);
     
     	// wait until transmission completed
-    	while(!(TWCR & (1<<TWINT)));
+    	if (i2c_wait()) continue;
     
     	// check value of TWI Status Register. Mask prescaler bits.
     	twst = TW_STATUS & 0xF8;
@@ -97,7 +155,7 @@ void i2c_start_wait(unsigned char address)
     	TWCR = (1<<TWINT) | (1<<TWEN);
     
     	// wail until transmission completed
-    	while(!(TWCR & (1<<TWINT)));
+    	if (i2c_wait()) continue;
     
     	// check value of TWI Status Register. Mask prescaler bits.
     	twst = TW_STATUS & 0xF8;
@@ -107,7 +165,7 @@ void i2c_start_wait(unsigned char address)
 	        TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWSTO);
 	        
 	        // wait until stop condition is executed and bus released
-	        while(TWCR & (1<<TWSTO));
+	        i2c_waitStop();
 	        
     	    continue;
     	}
@@ -115,6 +173,8 @@ void i2c_start_wait(unsigned char address)
     	break;
      }
 
+    return 0;
+
 }/* i2c_start_wait */
 
 
@@ -138,11 +198,11 @@ unsigned char i2c_rep_start(unsigned char address)
 *************************************************************************/
 void i2c_stop(void)
 {
-   /* send stop condition */
-	TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWSTO);
+   /* send stop condition, the slave side listens again afterwards */
+	TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWSTO) | TWI_IDLE_BITS;
 	
 	// wait until stop condition is executed and bus released
-	while(TWCR & (1<<TWSTO));
+	i2c_waitStop();
 
 }/* i2c_stop */
 
@@ -163,11 +223,15 @@ unsigned char i2c_write( unsigned char data )
 	TWCR = (1<<TWINT) | (1<<TWEN);
 
 	// wait until transmission completed
-	while(!(TWCR & (1<<TWINT)));
+	if (i2c_wait()) return 1;
 
 	// check value of TWI Status Register. Mask prescaler bits
 	twst = TW_STATUS & 0xF8;
-	if( twst != TW_MT_DATA_ACK) return 1;
+	if( twst != TW_MT_DATA_ACK)
+	{
+		perf_count(twiNacks_ui16);
+		return 1;
+	}
 	return 0;
 
 }/* i2c_write */
@@ -181,7 +245,7 @@ unsigned char i2c_write( unsigned char data )
 unsigned char i2c_readAck(void)
 {
 	TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWEA);
-	while(!(TWCR & (1<<TWINT)));    
+	if (i2c_wait()) return 0xFF;
 
     return TWDR;
 
@@ -196,54 +260,174 @@ unsigned char i2c_readAck(void)
 unsigned char i2c_readNak(void)
 {
 	TWCR = (1<<TWINT) | (1<<TWEN);
-	while(!(TWCR & (1<<TWINT)));
-	
+	if (i2c_wait()) return 0xFF;
+
     return TWDR;
 
 }/* i2c_readNak */
 
 
+/*************************************************************************
+  Send a block of bytes to the previously addressed I2C device
+
+  Input:    data bytes to be transfered
+            number of bytes
+  Return:   0 write successful
+            1 write failed, not acknowledged or bus timeout
+*************************************************************************/
+unsigned char i2c_writeBuffer(const unsigned char *data, unsigned char length)
+{
+	while(length--)
+	{
+		TWDR = *data++;
+		TWCR = (1<<TWINT) | (1<<TWEN);
+		if (i2c_wait()) return 1;
+		if ((TW_STATUS & 0xF8) != TW_MT_DATA_ACK)
+		{
+			perf_count(twiNacks_ui16);
+			return 1;
+		}
+	}
+	return 0;
+
+}/* i2c_writeBuffer */
+
+
+/*************************************************************************
+  Read a block of bytes from the previously addressed I2C device. All bytes
+  but the last one are acknowledged, the caller sends the stop condition.
+
+  Input:    buffer for the data
+            number of bytes
+  Return:   0 read successful
+            1 bus timeout
+*************************************************************************/
+unsigned char i2c_readBuffer(unsigned char *data, unsigned char length)
+{
+	while(length)
+	{
+		length--;
+		TWCR = (length != 0) ? ((1<<TWINT) | (1<<TWEN) | (1<<TWEA)) : ((1<<TWINT) | (1<<TWEN));
+		if (i2c_wait()) return 1;
+		*data++ = TWDR;
+	}
+	return 0;
+
+}/* i2c_readBuffer */
+
+
+/*************************************************************************
+  Write a block of bytes to the registers of a device, starting at reg
+
+  Input:    address of I2C device, without direction bit
+            first register
+            data bytes and number of bytes
+  Return:   0 write successful
+            1 write failed
+*************************************************************************/
+unsigned char i2c_writeRegister(unsigned char address, unsigned char reg, const unsigned char *data, unsigned char length)
+{
+	unsigned char ret;
+
+	ret = i2c_start(address + I2C_WRITE);
+	if (ret == 0) ret = i2c_write(reg);
+	if (ret == 0) ret = i2c_writeBuffer(data, length);
+	i2c_stop();
+	return ret;
+
+}/* i2c_writeRegister */
+
+
+/*************************************************************************
+  Read a block of bytes from the registers of a device, starting at reg
+
+  Input:    address of I2C device, without direction bit
+            first register
+            buffer for the data and number of bytes
+  Return:   0 read successful
+            1 read failed
+*************************************************************************/
+unsigned char i2c_readRegister(unsigned char address, unsigned char reg, unsigned char *data, unsigned char length)
+{
+	unsigned char ret;
+
+	ret = i2c_start(address + I2C_WRITE);
+	if (ret == 0) ret = i2c_write(reg);
+	if (ret == 0) ret = i2c_rep_start(address + I2C_READ);
+	if (ret == 0) ret = i2c_readBuffer(data, length);
+	i2c_stop();
+	return ret;
+
+}/* i2c_readRegister */
+
+
 /*************************************************************************
  Writes a data byte to a given address
 
  Input:  address of the eeprom to which the data should be written to
          data to be transfered
+
+ Return: E_OK if the eeprom took the byte and finished programming
 *************************************************************************/
-void write_eeprom_byte(uint16 address, uint8 data)
+Std_ReturnType write_eeprom_byte(uint16 address, uint8 data)
 {
-   uint16 status = 1;
-   i2c_start(EDID_EEPROM_ADDRESS + I2C_WRITE);
-   #if  EEPROM_WIDTH == EEPROM_ADDR_2_BYTES
-   i2c_write(address >> 8);
+   uint8 buffer[EEPROM_WIDTH + 1];
+   twi_TransactionType transaction;
+   timer_TickType start;
+
+#if  EEPROM_WIDTH == EEPROM_ADDR_2_BYTES
+   buffer[0] = (uint8)(address >> 8);
 #endif
-   i2c_write(address);
-   i2c_write(data);
-   i2c_stop();
-   while(status == 1)
+   buffer[EEPROM_WIDTH - 1] = (uint8)address;
+   buffer[EEPROM_WIDTH] = data;
+
+   transaction.address_ui8 = EDID_EEPROM_ADDRESS;
+   transaction.writeData_pui8 = buffer;
+   transaction.writeLength_ui8 = sizeof(buffer);
+   transaction.readLength_ui8 = 0;
+   if(twi_transfer(&transaction) != TWI_STATUS_OK)
    {
-      status = i2c_start(EDID_EEPROM_ADDRESS);
+      return E_NOT_OK;
    }
-   i2c_stop();
+
+   /* ack polling, the eeprom does not answer while it is programming */
+   transaction.writeLength_ui8 = 0;
+   start = timer_getTicks();
+   while(twi_transfer(&transaction) != TWI_STATUS_OK)
+   {
+      if(timer_elapsed(start) > TWI_BUSY_TIMEOUT_MS)
+      {
+         return E_NOT_OK;
+      }
+   }
+   return E_OK;
 }
 
 /*************************************************************************
- Writes a data byte to a given address
+ Reads a data byte from a given address
 
  Input:  address of the eeprom from which the data should be read
 
- Return: byte read from I2C device at specific address
+ Return: byte read from I2C device at specific address, 0 if the
+         transfer failed
 *************************************************************************/
 uint8 read_eeprom_byte(uint16 address)
 {
-   uint8 data;
-   i2c_start(EDID_EEPROM_ADDRESS + I2C_WRITE);
+   uint8 buffer[EEPROM_WIDTH];
+   uint8 data = 0;
+   twi_TransactionType transaction;
+
 #if  EEPROM_WIDTH == EEPROM_ADDR_2_BYTES
-   i2c_write(address >> 8);
+   buffer[0] = (uint8)(address >> 8);
 #endif
-   i2c_write(address);
-   i2c_start(EDID_EEPROM_ADDRESS + I2C_READ);
-   data = i2c_readNak();
-   i2c_stop();
+   buffer[EEPROM_WIDTH - 1] = (uint8)address;
+
+   transaction.address_ui8 = EDID_EEPROM_ADDRESS;
+   transaction.writeData_pui8 = buffer;
+   transaction.writeLength_ui8 = sizeof(buffer);
+   transaction.readData_pui8 = &data;
+   transaction.readLength_ui8 = 1;
+   (void)twi_transfer(&transaction);
+
    return(data);
 }
-
@@ -88,11 +88,9 @@
 
 #include <avr/io.h>
 
-/** defines the selection of the address bytes for the I2C device */
-enum{
-   EEPROM_ADDR_2_BYTES  = 2U,
-   EEPROM_ADDR_1_BYTES
-};
+/** defines the selection of the address bytes for the I2C device, also used as byte count */
+#define EEPROM_ADDR_1_BYTES  1U
+#define EEPROM_ADDR_2_BYTES  2U
 
 /** defines the bytes for addressing the I2C device */
 #define EEPROM_WIDTH EEPROM_ADDR_2_BYTES
@@ -148,11 +146,13 @@ unsigned char i2c_rep_start(unsigned char addr);
 /**
  @brief Issues a start condition and sends address and transfer direction 
    
- If device is busy, use ack polling to wait until device ready 
+ If device is busy, use ack polling to wait until device ready,
+ at most TWI_BUSY_TIMEOUT_MS
  @param    addr address and transfer direction of I2C device
- @return   none
+ @retval   0   device accessible
+ @retval   1   device still busy or bus error
  */
-void i2c_start_wait(unsigned char addr);
+unsigned char i2c_start_wait(unsigned char addr);
 
  
 /**
@@ -166,13 +166,13 @@ unsigned char i2c_write(unsigned char data);
 
 /**
  @brief    read one byte from the I2C device, request more data from device 
- @return   byte read from I2C device
+ @return   byte read from I2C device, 0xFF on a bus timeout
  */
 unsigned char i2c_readAck(void);
 
 /**
  @brief    read one byte from the I2C device, read is followed by a stop condition 
- @return   byte read from I2C device
+ @return   byte read from I2C device, 0xFF on a bus timeout
  */
 unsigned char i2c_readNak(void);
 
@@ -188,12 +188,54 @@ unsigned char i2c_readNak(void);
 unsigned char i2c_read(unsigned char ack);
 #define i2c_read(ack)  (ack) ? i2c_readAck() : i2c_readNak(); 
 
+/**
+ @brief    Send a block of bytes to the previously addressed I2C device
+ @param    data   bytes to be transfered
+ @param    length number of bytes
+ @retval   0 write successful
+ @retval   1 write failed
+ */
+unsigned char i2c_writeBuffer(const unsigned char *data, unsigned char length);
+
+/**
+ @brief    Read a block of bytes, all but the last one are acknowledged
+ @param    data   buffer for the bytes
+ @param    length number of bytes
+ @retval   0 read successful
+ @retval   1 bus timeout
+ */
+unsigned char i2c_readBuffer(unsigned char *data, unsigned char length);
+
+/**
+ @brief    Write a block of bytes to consecutive registers of a device
+ @param    addr   address of I2C device, without direction bit
+ @param    reg    first register
+ @param    data   bytes to be written
+ @param    length number of bytes
+ @retval   0 write successful
+ @retval   1 write failed
+ */
+unsigned char i2c_writeRegister(unsigned char addr, unsigned char reg, const unsigned char *data, unsigned char length);
+
+/**
+ @brief    Read a block of bytes from consecutive registers of a device
+ @param    addr   address of I2C device, without direction bit
+ @param    reg    first register
+ @param    data   buffer for the bytes
+ @param    length number of bytes
+ @retval   0 read successful
+ @retval   1 read failed
+ */
+unsigned char i2c_readRegister(unsigned char addr, unsigned char reg, unsigned char *data, unsigned char length);
+
 /**
  @brief  Writes a data byte to a given address
  @param    address specifies the the address to which the data should be written to
  @param    data specifies the data that should be written
+ @retval   E_OK     byte written and programmed
+ @retval   E_NOT_OK no answer or still busy after TWI_BUSY_TIMEOUT_MS
  */
-void write_eeprom_byte(uint16 address, uint8 data);
+Std_ReturnType write_eeprom_byte(uint16 address, uint8 data);
 
 /**
  @brief    Reads a data byte at a specific address
@@ -19,39 +19,50 @@
  */
 
 #include "uart.h"
+#include "../trace/trace.h"
+#include "../perf/perf.h"
 #include <avr/interrupt.h>
-#include <util/delay.h>
+#include <util/atomic.h>
+#include <stddef.h>
 
 /*--- Macros ---------------------------------------------------------*/
-/** Baudrate for UART communication */
-#define BAUD 9600UL
+#define UART_TX_MASK (UART_TX_BUFFER_SIZE - 1U)
 
-/** Calculated UBRR value for high baud rate */
-#define UBRR_VAL ((F_CPU+BAUD*8)/(BAUD*16)-1)
+#if (UART_TX_BUFFER_SIZE & UART_TX_MASK)
+#error "uart: the transmit buffer size must be a power of two"
+#endif
 
-/** Counter variable used for determining the type and the end of the received data set */
-uint8 uart_str_cnt = 0;
+/** States of the receive line buffer */
+#define UART_LINE_RECEIVING  0U
+#define UART_LINE_READY      1U
+#define UART_LINE_DISCARDING 2U
 
-/** Status variable, indicating whether a new data set is incoming (1) or not (0) */
-uint8 new_data = 0;
-
-/** Buffer holding the received data set */
-char uart_str[MAXUARTSTR] = "";
-
-/** Status variable, indicating whether the end of a data set has been found (\n\r) */
-uint8 block_finished = 0;
-
-/** Index of the beginning of a new data set within the UART buffer */
-uint8 new_data_index = 0;
-
-/*--- External Function Definitions ----------------------------------*/
-extern void command_ready(uart_i2cCommandType cmd, uint8 data);
-extern volatile uint8 checksum;
-extern volatile uint8 handshake_received;
-extern volatile uint8 continue_send_Checksum;
+/** UBRR values for uart_baudType, range checked in uart.h */
+static const uint16 uart_ubrr[UART_BAUD_COUNT] =
+{
+   (uint16)UART_UBRR(UART_BAUD),
+   (uint16)UART_UBRR(UART_BAUD_FAST_0),
+   (uint16)UART_UBRR(UART_BAUD_FAST_1),
+   (uint16)UART_UBRR(UART_BAUD_FAST_2)
+};
+
+/** Transmit ring, filled by uart_putc() and emptied by the data register empty interrupt */
+static volatile uint8 uart_txBuffer[UART_TX_BUFFER_SIZE];
+static volatile uint8 uart_txHead = 0;
+static volatile uint8 uart_txTail = 0;
+static volatile uint8 uart_txStarted = 0;
+
+/** Receive line buffer. The interrupt owns it while receiving, the main loop from
+ *  UART_LINE_READY until uart_releaseLine(), so a line is parsed where it was received */
+static char uart_line[UART_LINE_SIZE];
+static volatile uint8 uart_lineLength = 0;
+static volatile uint8 uart_lineState = UART_LINE_RECEIVING;
+
+/*--- Internal Function Declarations ---------------------------------*/
+static void uart_txNext(void);
 
 /**
- * @brief Initialize UART communication with given parameters rxen, txen, rxcie and BAUD_VAL_HIGH
+ * @brief Initialize UART communication with given parameters rxen, txen, rxcie and UART_BAUD
  *
  * @param[in] rxen   enable receiving
  * @param[in] txen   enable transmitting
@@ -59,22 +70,39 @@ extern volatile uint8 continue_send_Checksum;
  */
 void uart_init(uart_rxenType rxen, uart_txenType txen, uart_rxieType rxcie)
 {
+   UCSR0A = (1 << U2X0);
    UCSR0B = ((uint8)rxen << RXEN0) | ((uint8)rxcie << RXCIE0) | ((uint8)txen << TXEN0);
    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
-   UBRR0H = UBRR_VAL >> 8;
-   UBRR0L = UBRR_VAL & 0xFF;
+   UBRR0H = uart_ubrr[UART_BAUD_NORMAL] >> 8;
+   UBRR0L = uart_ubrr[UART_BAUD_NORMAL] & 0xFF;
 }
 
 /**
- * @brief Sends a single character via UART
+ * @brief Queues a single character, waits only while the transmit ring is full
  *
  * @param[in] c byte to send
  */
 void uart_putc(uint8 byte)
 {
-   while (!(UCSR0A & (1 << UDRE0)));
-   UDR0 = byte;         /* sende Zeichen */
+   uint8 head = (uint8)((uart_txHead + 1U) & UART_TX_MASK);
 
+   if (head == uart_txTail) {
+      perf_count(uartTxFull_ui16);
+   }
+   while (head == uart_txTail) {
+      /* with the interrupts off, e.g. before sei(), the ring is emptied by hand */
+      if (!(SREG & (1 << SREG_I)) && (UCSR0A & (1 << UDRE0))) {
+         uart_txNext();
+      }
+   }
+   uart_txStarted = 1;
+   uart_txBuffer[uart_txHead] = byte;
+   uart_txHead = head;
+   if (!(UCSR0B & (1 << UDRIE0))) {
+      /* the transmitter was idle, a new burst starts */
+      trace_event(TRACE_UART_TX, byte);
+   }
+   UCSR0B |= (1 << UDRIE0);
 }
 
 /**
@@ -85,10 +113,138 @@ void uart_putc(uint8 byte)
 void uart_puts(const uint8 *s) {
    while (*s ) {
       uart_putc(*s);
-      _delay_us(10);
       s++;
    }
 }
 
+/**
+ * @brief Transmit a binary block
+ *
+ * @param[in] data   pointer to the bytes to send
+ * @param[in] length number of bytes
+ */
+void uart_write(const uint8 *data, uint16 length)
+{
+   while (length--) {
+      uart_putc(*data++);
+   }
+}
+
+/**
+ * @brief Waits until the last byte has left the shift register
+ */
+void uart_flush(void)
+{
+   if (!uart_txStarted) {
+      return;
+   }
+   while (uart_txHead != uart_txTail) {
+      if (!(SREG & (1 << SREG_I)) && (UCSR0A & (1 << UDRE0))) {
+         uart_txNext();
+      }
+   }
+   while (!(UCSR0A & (1 << TXC0)));
+}
 
+/**
+ * @brief Switches the baudrate after all pending bytes are sent
+ *
+ * @param[in] baud one of the baudrates checked in uart.h
+ */
+void uart_setBaud(uart_baudType baud)
+{
+   uart_flush();
+   UBRR0H = uart_ubrr[baud] >> 8;
+   UBRR0L = uart_ubrr[baud] & 0xFF;
+}
 
+/**
+ * @brief Returns the received line, terminated by '\r' or '\n' and without it
+ *
+ * @return the zero terminated line, it may be modified in place, or NULL if none is complete
+ */
+char *uart_getLine(void)
+{
+   return (uart_lineState == UART_LINE_READY) ? uart_line : NULL;
+}
+
+/**
+ * @brief Hands the line buffer back to the receive interrupt
+ */
+void uart_releaseLine(void)
+{
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      uart_lineLength = 0;
+      uart_lineState = UART_LINE_RECEIVING;
+   }
+}
+
+/*--- Internal Function Definitions ----------------------------------*/
+
+/**
+ * @brief Hands the next byte of the ring to the hardware, stops the interrupt when empty
+ */
+static void uart_txNext(void)
+{
+   if (uart_txHead == uart_txTail) {
+      UCSR0B &= ~(1 << UDRIE0);
+   }
+   else {
+      UDR0 = uart_txBuffer[uart_txTail];
+      uart_txTail = (uint8)((uart_txTail + 1U) & UART_TX_MASK);
+      /* TXC is cleared by writing a one, uart_flush() waits for it. a plain write, a
+       * read-modify-write would write back the other flags; U2X0 as set by uart_init() */
+      UCSR0A = (1 << U2X0) | (1 << TXC0);
+   }
+}
+
+/*--- Interrupt Service Routines -------------------------------------*/
+
+/**
+ * @brief Data register empty
+ */
+ISR(USART_UDRE_vect)
+{
+   trace_event(TRACE_ISR_ENTRY, TRACE_ISR_UART_UDRE);
+   perf_count(isrUartUdre_ui16);
+   uart_txNext();
+   trace_event(TRACE_ISR_EXIT, TRACE_ISR_UART_UDRE);
+}
+
+/**
+ * @brief Receive complete, collects a line. Empty lines are ignored, a line that does not
+ * fit is dropped up to its end, everything is dropped while a line waits to be taken.
+ */
+ISR(USART_RX_vect)
+{
+   uint8 byte = UDR0;
+
+   trace_event(TRACE_ISR_ENTRY, TRACE_ISR_UART_RX);
+   perf_count(isrUartRx_ui16);
+   if ((byte == '\r') || (byte == '\n')) {
+      if (uart_lineState == UART_LINE_DISCARDING) {
+         uart_lineLength = 0;
+         uart_lineState = UART_LINE_RECEIVING;
+      }
+      else if ((uart_lineState == UART_LINE_RECEIVING) && (uart_lineLength > 0)) {
+         uart_line[uart_lineLength] = '\0';
+         uart_lineState = UART_LINE_READY;
+         trace_event(TRACE_UART_LINE, uart_lineLength);
+      }
+      else {
+         /* empty line or the second half of "\r\n" */
+      }
+   }
+   else if (uart_lineState == UART_LINE_RECEIVING) {
+      if (uart_lineLength < (UART_LINE_SIZE - 1U)) {
+         uart_line[uart_lineLength++] = (char)byte;
+      }
+      else {
+         uart_lineState = UART_LINE_DISCARDING;
+      }
+   }
+   else {
+      /* dropped */
+   }
+   trace_event(TRACE_ISR_EXIT, TRACE_ISR_UART_RX);
+}
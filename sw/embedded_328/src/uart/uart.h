@@ -27,20 +27,38 @@
 #include <avr/io.h>
 #include "../inc/std_types.h"
 
-/** The maximum size of a string that is sent via UART */
-#define MAXUARTSTR 250
+/** Baudrate for normal UART communication */
+#define UART_BAUD               9600UL
 
-typedef enum
-{
-   CMD_WRITE_START = 0U,
-   CMD_WRITE_DATA,
-   CMD_WRITE_STOP,
-   CMD_ERROR,
-   CMD_DBG,
-   CMD_CHECKSUM,
-   CMD_STOP_CHECKSUM,
-   CMD_HANDSHAKE
-}uart_i2cCommandType;
+/** Baudrates a dump may switch to, all exact at 16 MHz with U2X */
+#define UART_BAUD_FAST_0        250000UL
+#define UART_BAUD_FAST_1        500000UL
+#define UART_BAUD_FAST_2        1000000UL
+
+/** UBRR value in double speed mode and the resulting error in per mille */
+#define UART_UBRR(baud)         (((F_CPU) + 4UL * (baud)) / (8UL * (baud)) - 1UL)
+#define UART_REAL_BAUD(baud)    ((F_CPU) / (8UL * (UART_UBRR(baud) + 1UL)))
+#define UART_ERROR_PERMILLE(baud) \
+   ((UART_REAL_BAUD(baud) > (baud)) ? ((UART_REAL_BAUD(baud) - (baud)) * 1000UL / (baud)) \
+                                    : (((baud) - UART_REAL_BAUD(baud)) * 1000UL / (baud)))
+
+/** more than 2% error on both sides is too much for 8N1 */
+#define UART_MAX_ERROR_PERMILLE 10UL
+
+#if (UART_ERROR_PERMILLE(UART_BAUD) > UART_MAX_ERROR_PERMILLE) || (UART_UBRR(UART_BAUD) > 4095UL)
+#error "uart: UART_BAUD not possible with this F_CPU"
+#endif
+#if (UART_ERROR_PERMILLE(UART_BAUD_FAST_0) > UART_MAX_ERROR_PERMILLE) || \
+    (UART_ERROR_PERMILLE(UART_BAUD_FAST_1) > UART_MAX_ERROR_PERMILLE) || \
+    (UART_ERROR_PERMILLE(UART_BAUD_FAST_2) > UART_MAX_ERROR_PERMILLE)
+#error "uart: a fast baudrate is not possible with this F_CPU"
+#endif
+
+/** Size of the transmit ring buffer, a power of two */
+#define UART_TX_BUFFER_SIZE     64U
+
+/** Size of the receive line buffer including the terminating zero, longer lines are dropped */
+#define UART_LINE_SIZE          32U
 
 typedef enum
 {
@@ -60,12 +78,26 @@ typedef enum
    INTERRUPT_ENABLED
 }uart_rxieType;
 
+typedef enum
+{
+   UART_BAUD_NORMAL = 0U,
+   UART_BAUD_FAST_250K,
+   UART_BAUD_FAST_500K,
+   UART_BAUD_FAST_1M,
+   UART_BAUD_COUNT
+}uart_baudType;
+
 
 /*--- Function Prototypes --------------------------------------------*/
 
 void uart_init(uart_rxenType rxen, uart_txenType txen, uart_rxieType rxcie);
 void uart_putc(uint8 byte);
 void uart_puts(const uint8 *s);
+void uart_write(const uint8 *data, uint16 length);
+void uart_flush(void);
+void uart_setBaud(uart_baudType baud);
+char *uart_getLine(void);
+void uart_releaseLine(void);
 
 
 #endif /* #ifndef _UART_H_ */
@@ -1,6 +1,7 @@
 #ifndef PLATFORM_TYPES_H
 #define PLATFORM_TYPES_H
 
+#include <stdint.h>
 
 #define FALSE 			0
 #define TRUE 			1
@@ -15,15 +16,16 @@
 #define MASK_32BIT_3BYTE_UI32	0x00FF0000
 #define MASK_32BIT_4BYTE_UI32	0xFF000000
 
-typedef unsigned char      boolean;
-typedef signed char        sint8;
-typedef unsigned char      uint8;
-typedef signed short       sint16;
-typedef unsigned short     uint16;
-typedef signed long        sint32;
-typedef unsigned long      uint32;
-typedef signed long long   sint64;
-typedef unsigned long long uint64;
+/* fixed widths, so the core builds for the host too (sw/host) */
+typedef uint8_t            boolean;
+typedef int8_t             sint8;
+typedef uint8_t            uint8;
+typedef int16_t            sint16;
+typedef uint16_t           uint16;
+typedef int32_t            sint32;
+typedef uint32_t           uint32;
+typedef int64_t            sint64;
+typedef uint64_t           uint64;
 typedef float              float32;
 typedef double             float64;
 
@@ -5,11 +5,13 @@
  *
  * author:      Armin Schlegel, Mr. L.
  * date:        09.10.2014
- * version:     0.3   worky, testing
+ * version:     0.4   worky, testing
  *
  * file history:
  *          09.10.2014  A. Schlegel file created, basic version
  *          14.10.2014  Mr. L.      strutural improvements, nicify layout, add comments
+ *          19.10.2026  agent configuration is folded at compile time, see adc_lcfg.h
+ *          19.10.2026  agent averaging depth settable at runtime
  *
  * notes:
  *          - none -
@@ -33,13 +35,8 @@
 
 /* ------------------------------------ DEFINES ------------------------------------------------- */
 
-#define ADC_CALLBACK_NULL_PTR ((void*)0)
-
-
 /* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
 
-typedef void (*adc_CallbackType)(uint16);
-
 typedef enum
 {
     ADC_REFERENCE_AREF = 0U,
@@ -123,38 +120,15 @@ typedef enum
     ADC_AVERAGE_32_SAMPLES
 }adc_AverageType_e;
 
-typedef struct
-{
-    adc_EnableStateType_e           enableState_e;
-    adc_InterruptStateType_e        interruptState_e;
-    adc_PrescalerType_e             prescalerControl_e;
-    adc_TriggerType_e               triggerControl_e;
-    adc_ReferenceType_e             referenceControl_e;
-    adc_ChannelType_e               defaultChannel_e;
-    adc_DigitalInputDisableType_e   digitalInputDisable_e;
-    adc_CallbackType                callbackFunc_pv;
-    adc_AverageType_e               averageControl_e;
-}adc_ConfigType;
-
-typedef struct
-{
-    uint8* adc_DataRegisterLow_pui8;
-    uint8* adc_DataRegisterHigh_pui8;
-    uint8* adc_ControlAndStatusRegisterA_pui8;
-    uint8* adc_ControlAndStatusRegisterB_pui8;
-    uint8* adc_MuxRegister_pui8;
-    uint8* adc_DigitalInputDisableRegister_pui8;
-} adc_RegisterAddressType;
-
-
 /* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
 
 
 /* ------------------------------------ PROTOTYPES ---------------------------------------------- */
 
-void adc_init(const adc_ConfigType *configPtr);
+void adc_init(void);
 void adc_disableDigitalInput(const adc_ChannelType_e channels);
 void adc_setChannel(const adc_ChannelType_e channel);
+void adc_setAverage(const adc_AverageType_e average_e);
 uint16 adc_read10bit(void);
 uint16 adc_read10bitAverage(void);
 uint8 adc_read8bit(void);
@@ -1,15 +1,16 @@
 /* *************************************************************************************************
  * file:        adc_cfg.h
  *
- *          The adc module address configuration file.
+ *          The adc module register configuration file.
  *
  * author:      Armin Schlegel, Mr. L.
  * date:        09.10.2014
- * version:     0.3   worky, testing
+ * version:     0.4   worky, testing
  *
  * file history:
  *          09.10.2014  A. Schlegel file created, basic version
  *          14.10.2014  Mr. L.      renaming, add DIDR0 defines, nicify layout, add comments
+ *          19.10.2026  agent register values folded from adc_lcfg.h, drop addresses
  *
  * notes:
  *          - none -
@@ -24,14 +25,6 @@
 
 /* ------------------------------------ DEFINES ------------------------------------------------- */
 
-/* register addresses */
-#define ADC_ADCL_ADDRESS    ((uint8)0x24)
-#define ADC_ADCH_ADDRESS    ((uint8)0x25)
-#define ADC_ADCSRA_ADDRESS  ((uint8)0x26)
-#define ADC_ADCSRB_ADDRESS  ((uint8)0x23)
-#define ADC_ADMUX_ADDRESS   ((uint8)0x27)
-#define ADC_DIDR0_ADDRESS   ((uint8)0x21)
-
 /* ADMUX register bit positions */
 #define ADC_REFS1 ((uint8)7)
 #define ADC_REFS0 ((uint8)6)
@@ -71,6 +64,21 @@
 #define ADC_ADC0D ((uint8)0)
 
 
+/* register values of the configuration in adc_lcfg.h. these are constant expressions, the
+ * compiler folds them into immediate stores.
+ */
+#define ADC_ADCSRA_VALUE    ((uint8)(((uint8)ADC_CFG_ENABLE_STATE << ADC_ADEN) | \
+                                     ((uint8)ADC_CFG_PRESCALER << ADC_ADPS0)))
+#define ADC_ADCSRA_RUN      ((uint8)(ADC_ADCSRA_VALUE | \
+                                     ((ADC_CFG_TRIGGER != ADC_TRIGGER_SINGLE_SHOT) ? (1 << ADC_ADATE) : 0) | \
+                                     ((uint8)ADC_CFG_INTERRUPT_STATE << ADC_ADIE)))
+#define ADC_ADCSRB_VALUE    ((uint8)((ADC_CFG_TRIGGER != ADC_TRIGGER_SINGLE_SHOT) ? \
+                                     ((uint8)ADC_CFG_TRIGGER << ADC_ADTS0) : 0))
+#define ADC_ADMUX_REFERENCE ((uint8)((uint8)ADC_CFG_REFERENCE << ADC_REFS0))
+#define ADC_ADMUX_VALUE     ((uint8)(ADC_ADMUX_REFERENCE | ((uint8)ADC_CFG_DEFAULT_CHANNEL << ADC_MUX0)))
+#define ADC_DIDR0_VALUE     ((uint8)ADC_CFG_DIGITAL_INPUT_DISABLE)
+
+
 /* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
 
 /* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
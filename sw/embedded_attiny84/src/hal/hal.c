@@ -0,0 +1,94 @@
+/* *************************************************************************************************
+ * file:        hal.c
+ *
+ *          The hardware abstraction of the avr targets.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent trace the led changes
+ *
+ * notes:
+ *          the channels are averaged as set by adc_setAverage(), ADC_CFG_AVERAGE at start.
+ *          adc_setChannel() throws the first conversion after a change of the channel away,
+ *          the switch and the battery alternate every cycle.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <util/delay.h>
+#include "hal.h"
+#include "hal_cfg.h"
+#include "../trace/trace.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+/* bit 0 of the led mask first */
+static const gpio_ChannelType hal_leds_ae[HAL_NUM_OF_LEDS] = HAL_LED_CHANNELS;
+
+static const adc_ChannelType_e hal_channels_ae[HAL_CHANNEL_COUNT] = HAL_ADC_CHANNELS;
+
+#if (TRACE_MODE == STD_ON)
+static uint8 hal_leds_ui8;                      // last written mask, the trace sees the changes
+#endif
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void hal_init(void)
+{
+    gpio_init();
+    adc_init();
+}
+
+uint16 hal_readChannel(hal_ChannelType channel_e)
+{
+    adc_setChannel(hal_channels_ae[channel_e]);
+    return adc_read10bitAverage();
+}
+
+void hal_writeLeds(uint8 mask_ui8)
+{
+    uint8 led_ui8;
+
+#if (TRACE_MODE == STD_ON)
+    if (mask_ui8 != hal_leds_ui8)
+    {
+        hal_leds_ui8 = mask_ui8;
+        trace_event(TRACE_LED, mask_ui8);
+    }
+#endif
+
+    for (led_ui8 = 0; led_ui8 < HAL_NUM_OF_LEDS; led_ui8++)
+    {
+        gpio_WriteChannel(hal_leds_ae[led_ui8], (gpio_PinState)((mask_ui8 >> led_ui8) & 0x01));
+    }
+}
+
+/* _delay_ms() needs a constant, so the time is waited in steps of 1ms */
+void hal_delayMs(uint16 milliSeconds_ui16)
+{
+    while (milliSeconds_ui16-- > 0U)
+    {
+        _delay_ms(1);
+    }
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+
+/* ************************************ E O F *************************************************** */
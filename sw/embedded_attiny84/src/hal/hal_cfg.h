@@ -0,0 +1,37 @@
+/* *************************************************************************************************
+ * file:        hal_cfg.h
+ *
+ *          The hardware abstraction configuration of the ATtiny84 board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HAL_CFG_H_
+#define _HAL_CFG_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../gpio/gpio.h"
+#include "../adc/adc.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* the top segment first, the bottom segment stays lit down to 20% */
+#define HAL_LED_CHANNELS            {GPIO_CHANNEL_PA2, GPIO_CHANNEL_PA3, GPIO_CHANNEL_PA4, GPIO_CHANNEL_PA5, GPIO_CHANNEL_PA6}
+
+/* in the order of hal_ChannelType */
+#define HAL_ADC_CHANNELS            {ADC_CHANNEL_0, ADC_CHANNEL_1}
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _HAL_CFG_H_ */
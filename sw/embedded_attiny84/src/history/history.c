@@ -0,0 +1,182 @@
+/* *************************************************************************************************
+ * file:        history.c
+ *
+ *          The history module, min/avg/max of the cell voltage in three resolutions.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent performance counters
+ *          19.10.2026  agent no save from history_add(), only the main loop saves
+ *
+ * notes:
+ *          every level keeps a running min, max and sum of the slots it consolidates. when
+ *          enough are in, the result becomes a slot of the level and is handed on to the
+ *          next level, so a sample costs O(1) no matter how long the history is.
+ *
+ *          level 0 is lost when the power goes, levels 1 and 2 are saved to eeprom only by
+ *          history_save(). history_add() never writes the eeprom, the main loop saves when
+ *          the display goes dark, before the pack may be unplugged.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/eeprom.h>
+#include "history.h"
+#include "../perf/perf.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define HISTORY_SAVED_LEVELS        (HISTORY_NUM_OF_LEVELS - 1U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* slot of a level that is being consolidated */
+typedef struct
+{
+    uint16  sum_ui16;
+    uint8   min_ui8;
+    uint8   max_ui8;
+    uint8   count_ui8;
+}history_AccumulatorType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+/* inputs that make up one slot of each level */
+static const uint8 history_slotInputs_aui8[HISTORY_NUM_OF_LEVELS] =
+{
+    HISTORY_LEVEL0_CYCLES, HISTORY_LEVEL1_SLOTS, HISTORY_LEVEL2_SLOTS
+};
+
+static history_LevelType history_levelsEeprom_as[HISTORY_SAVED_LEVELS] EEMEM;
+
+static history_DataType history_data_s;
+static history_AccumulatorType history_accumulators_as[HISTORY_NUM_OF_LEVELS];
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static uint8 history_encode(uint16 cellMilliVolt_ui16);
+static void history_consolidate(uint8 level_ui8, const history_SlotType *input_ps);
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void history_init(void)
+{
+    uint8 level_ui8;
+
+    history_data_s.levels_as[0].head_ui8 = 0;
+    history_data_s.levels_as[0].count_ui8 = 0;
+    eeprom_read_block(&history_data_s.levels_as[1], history_levelsEeprom_as, sizeof(history_levelsEeprom_as));
+
+    for (level_ui8 = 0; level_ui8 < HISTORY_NUM_OF_LEVELS; level_ui8++)
+    {
+        history_LevelType *level_ps = &history_data_s.levels_as[level_ui8];
+
+        /* an erased eeprom reads 0xFF */
+        if ((level_ps->head_ui8 >= HISTORY_DEPTH) || (level_ps->count_ui8 > HISTORY_DEPTH))
+        {
+            level_ps->head_ui8 = 0;
+            level_ps->count_ui8 = 0;
+        }
+        history_accumulators_as[level_ui8].count_ui8 = 0;
+    }
+}
+
+/* one call per HISTORY_CYCLE_MS */
+void history_add(uint16 cellMilliVolt_ui16)
+{
+    history_SlotType sample_s;
+
+    sample_s.min_ui8 = history_encode(cellMilliVolt_ui16);
+    sample_s.avg_ui8 = sample_s.min_ui8;
+    sample_s.max_ui8 = sample_s.min_ui8;
+    history_consolidate(0, &sample_s);
+}
+
+/* only the changed bytes are written */
+void history_save(void)
+{
+    perf_count(eepromWrites_ui16);
+    eeprom_update_block(&history_data_s.levels_as[1], history_levelsEeprom_as, sizeof(history_levelsEeprom_as));
+}
+
+const history_DataType *history_get(void)
+{
+    return &history_data_s;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+static uint8 history_encode(uint16 cellMilliVolt_ui16)
+{
+    uint16 steps_ui16;
+
+    if (cellMilliVolt_ui16 <= HISTORY_OFFSET_MV)
+    {
+        return 0;
+    }
+    steps_ui16 = (uint16)((cellMilliVolt_ui16 - HISTORY_OFFSET_MV + HISTORY_STEP_MV / 2U) / HISTORY_STEP_MV);
+    return (steps_ui16 > 255U) ? 255U : (uint8)steps_ui16;
+}
+
+static void history_consolidate(uint8 level_ui8, const history_SlotType *input_ps)
+{
+    history_AccumulatorType *accumulator_ps;
+    history_LevelType *level_ps;
+    history_SlotType slot_s;
+
+    /* a loop instead of recursion, the stack of the tiny is small */
+    for (; level_ui8 < HISTORY_NUM_OF_LEVELS; level_ui8++)
+    {
+        accumulator_ps = &history_accumulators_as[level_ui8];
+        level_ps = &history_data_s.levels_as[level_ui8];
+
+        if (accumulator_ps->count_ui8 == 0)
+        {
+            accumulator_ps->sum_ui16 = 0;
+            accumulator_ps->min_ui8 = input_ps->min_ui8;
+            accumulator_ps->max_ui8 = input_ps->max_ui8;
+        }
+        accumulator_ps->sum_ui16 += input_ps->avg_ui8;
+        if (input_ps->min_ui8 < accumulator_ps->min_ui8)
+        {
+            accumulator_ps->min_ui8 = input_ps->min_ui8;
+        }
+        if (input_ps->max_ui8 > accumulator_ps->max_ui8)
+        {
+            accumulator_ps->max_ui8 = input_ps->max_ui8;
+        }
+
+        if (++accumulator_ps->count_ui8 < history_slotInputs_aui8[level_ui8])
+        {
+            return;
+        }
+
+        slot_s.min_ui8 = accumulator_ps->min_ui8;
+        slot_s.max_ui8 = accumulator_ps->max_ui8;
+        slot_s.avg_ui8 = (uint8)((accumulator_ps->sum_ui16 + accumulator_ps->count_ui8 / 2U) / accumulator_ps->count_ui8);
+        accumulator_ps->count_ui8 = 0;
+
+        level_ps->slots_as[level_ps->head_ui8] = slot_s;
+        level_ps->head_ui8 = (uint8)((level_ps->head_ui8 + 1U) % HISTORY_DEPTH);
+        if (level_ps->count_ui8 < HISTORY_DEPTH)
+        {
+            level_ps->count_ui8++;
+        }
+
+        input_ps = &slot_s;
+    }
+}
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,40 @@
+/* *************************************************************************************************
+ * file:        history_cfg.h
+ *
+ *          The history module configuration file.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          every level costs HISTORY_DEPTH * 3 + 2 bytes of ram, the slow levels the same
+ *          again in eeprom. 16 slots keep the three levels at 150 bytes of the 512.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HISTORY_CFG_H_
+#define _HISTORY_CFG_H_
+/* ============================================================================================== */
+
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* slots per level */
+#define HISTORY_DEPTH               (16U)
+
+/* history_add() is called once per main loop cycle */
+#define HISTORY_CYCLE_MS            (500U)
+
+/* level 0: 1s, level 1: 1min, level 2: 15min per slot */
+#define HISTORY_LEVEL0_CYCLES       (1000U / HISTORY_CYCLE_MS)
+#define HISTORY_LEVEL1_SLOTS        (60U)
+#define HISTORY_LEVEL2_SLOTS        (15U)
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _HISTORY_CFG_H_ */
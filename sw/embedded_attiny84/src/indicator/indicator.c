@@ -0,0 +1,327 @@
+/* *************************************************************************************************
+ * file:        indicator.c
+ *
+ *          The indicator module, the decisions behind the led bar.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, moved out of main.c of both targets
+ *          19.10.2026  agent checkUbatState() rejects a cell count out of range
+ *          19.10.2026  agent a change of the chemistry clears the latched cell count
+ *          19.10.2026  agent the switch windows of 5 and 6 cells no longer overlap
+ *          19.10.2026  agent the cell count windows start at the detection floor of the profile
+ *          19.10.2026  agent a hysteresis band per threshold, see hysteresis_digits()
+ *
+ * notes:
+ *          the functions keep their state in static variables, there is one indicator.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include "indicator.h"
+#include "../hal/hal.h"
+#include "../soc/soc.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+#if (INDICATOR_SETTINGS == STD_OFF)
+/* state of charge below which the 80%, 60%, 40% and 20% levels are shown */
+const uint8 indicator_thresholdPercent_aui8[NUM_OF_THRESHOLDS] = INDICATOR_THRESHOLDS;
+#endif
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+/* the level thresholds of the current cell count in ADC digits, see setCellThresholds() */
+static uint16 cellThresholds[NUM_OF_THRESHOLDS];
+
+/* the hysteresis band of each threshold in ADC digits, set with the thresholds. a level is
+ * only left if the reading is further than the band away from the threshold it crosses.
+ */
+static uint8 cellHysteresis[NUM_OF_THRESHOLDS];
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+lipoCellSwitchType checkLipoSwitch(uint16 adc_channel)
+{
+   lipoCellSwitchType lipoSwitch = SWITCH_CELL_NONE;
+   if(in_switch_window(adc_channel, LIPO_CELL_BELOW_1, LIPO_CELL_1, LIPO_CELL_2))
+   {
+      lipoSwitch = SWITCH_CELL_1;
+   }
+   else if(in_switch_window(adc_channel, LIPO_CELL_1, LIPO_CELL_2, LIPO_CELL_3))
+   {
+      lipoSwitch = SWITCH_CELL_2;
+   }
+   else if(in_switch_window(adc_channel, LIPO_CELL_2, LIPO_CELL_3, LIPO_CELL_4))
+   {
+      lipoSwitch = SWITCH_CELL_3;
+   }
+   else if(in_switch_window(adc_channel, LIPO_CELL_3, LIPO_CELL_4, LIPO_CELL_5))
+   {
+      lipoSwitch = SWITCH_CELL_4;
+   }
+   else if(in_switch_window(adc_channel, LIPO_CELL_4, LIPO_CELL_5, LIPO_CELL_6))
+   {
+      lipoSwitch = SWITCH_CELL_5;
+   }
+   else if(in_switch_window(adc_channel, LIPO_CELL_5, LIPO_CELL_6, LIPO_CELL_ABOVE_6))
+   {
+      lipoSwitch = SWITCH_CELL_6;
+   }
+   else
+   {
+      lipoSwitch = SWITCH_CELL_NONE;
+   }
+   return lipoSwitch;
+}
+
+
+
+/* looks up the pack voltage of each level on the discharge curve and caches it and its
+ * hysteresis band in ADC digits, so the cyclic decision is a plain compare.
+ */
+void setCellThresholds(lipoCellSwitchType cells)
+{
+   uint8 level;
+
+   for(level = 0; level < NUM_OF_THRESHOLDS; level++)
+   {
+      cellThresholds[level] = ubat_millivolt_to_digit((uint32)soc_getCellMilliVolt(indicator_thresholdPercent(level)) * cells);
+      cellHysteresis[level] = hysteresis_digits(cellThresholds[level]);
+   }
+}
+
+/* accepts a new switch position only after SWITCH_DEBOUNCE_SAMPLES equal decodes in a row */
+lipoCellSwitchType debounceLipoSwitch(lipoCellSwitchType lipoSwitch)
+{
+   static lipoCellSwitchType confirmedSwitch = SWITCH_CELL_NONE;
+   static lipoCellSwitchType candidateSwitch = SWITCH_CELL_NONE;
+   static uint8 candidateCount = 0;
+
+   if(lipoSwitch == confirmedSwitch)
+   {
+      candidateCount = 0;
+   }
+   else if(lipoSwitch != candidateSwitch)
+   {
+      candidateSwitch = lipoSwitch;
+      candidateCount = 1;
+   }
+   else if(++candidateCount >= SWITCH_DEBOUNCE_SAMPLES)
+   {
+      confirmedSwitch = candidateSwitch;
+      candidateCount = 0;
+   }
+   else
+   {
+      /* keep counting */
+   }
+
+   return confirmedSwitch;
+}
+
+/* returns the only cell count whose window [cells * detect, cells * (full + margin)] of the
+ * active chemistry holds the pack voltage. the floors of soc_lcfg.c keep the windows of 1 to
+ * 6 cells apart, a pack below its floor is in no window and SWITCH_CELL_NONE is returned. the
+ * check for more than one window stays for profiles with a lower floor.
+ */
+lipoCellSwitchType detectLipoCells(uint16 ubatMilliVolt)
+{
+   const soc_ProfileType *profile = soc_getProfile();
+   lipoCellSwitchType detectedCells = SWITCH_CELL_NONE;
+   uint8 matches = 0;
+   uint8 cells;
+
+   for(cells = 1; cells <= MAX_NUM_OF_CELLS; cells++)
+   {
+      if((ubatMilliVolt >= ((uint32)cells * profile->detectMilliVolt_ui16)) &&
+         (ubatMilliVolt <= ((uint32)cells * (profile->fullMilliVolt_ui16 + CELL_DETECTION_MARGIN_MV))))
+      {
+         detectedCells = (lipoCellSwitchType)cells;
+         matches++;
+      }
+   }
+
+   return (matches == 1) ? detectedCells : SWITCH_CELL_NONE;
+}
+
+/* latches the cell count after CELL_DETECTION_SAMPLES equal detections in a row. the
+ * latch holds until the next reset, i.e. until the next pack is plugged in, or until the
+ * chemistry changes, its windows give other counts.
+ */
+lipoCellSwitchType latchLipoCells(lipoCellSwitchType detectedCells)
+{
+   static lipoCellSwitchType latchedCells = SWITCH_CELL_NONE;
+   static lipoCellSwitchType candidateCells = SWITCH_CELL_NONE;
+   static uint8 candidateCount = 0;
+   static soc_ChemistryType latchedChemistry = SOC_CHEMISTRY_LIPO;
+
+   if(soc_getChemistry() != latchedChemistry)
+   {
+      latchedChemistry = soc_getChemistry();
+      latchedCells = SWITCH_CELL_NONE;
+      candidateCells = SWITCH_CELL_NONE;
+      candidateCount = 0;
+   }
+
+   if(latchedCells != SWITCH_CELL_NONE)
+   {
+      /* already latched */
+   }
+   else if((detectedCells == SWITCH_CELL_NONE) || (detectedCells != candidateCells))
+   {
+      candidateCells = detectedCells;
+      candidateCount = (detectedCells == SWITCH_CELL_NONE) ? 0 : 1;
+   }
+   else if(++candidateCount >= CELL_DETECTION_SAMPLES)
+   {
+      latchedCells = candidateCells;
+   }
+   else
+   {
+      /* keep counting */
+   }
+
+   return latchedCells;
+}
+
+/* the level is kept between calls. after a change of the cell count or the settings it is
+ * decided from scratch, afterwards it only moves if the reading leaves the hysteresis band.
+ * without a cell count there are no thresholds, LED_INVALID is returned and the level kept.
+ */
+ledPercentIndicatorType checkUbatState(lipoCellSwitchType cells, uint16 ubatChannel)
+{
+   static ledPercentIndicatorType ledPercentIndicator = LED_FULL;
+   static lipoCellSwitchType lastCells = SWITCH_CELL_NONE;
+   static uint8 lastRevision = 0;
+   const uint16 *thresholds = cellThresholds;
+
+   if((cells == SWITCH_CELL_NONE) || (cells > MAX_NUM_OF_CELLS))
+   {
+      return LED_INVALID;
+   }
+
+   if((cells != lastCells) || (indicator_revision() != lastRevision))
+   {
+      setCellThresholds(cells);
+      lastRevision = indicator_revision();
+      ledPercentIndicator = LED_FULL;
+      while((ledPercentIndicator < LED_UNDER_20_PERCENT) && (ubatChannel < thresholds[ledPercentIndicator]))
+      {
+         ledPercentIndicator++;
+      }
+      lastCells = cells;
+   }
+   else
+   {
+      /* falling below the next threshold */
+      while((ledPercentIndicator < LED_UNDER_20_PERCENT) && ((ubatChannel + cellHysteresis[ledPercentIndicator]) < thresholds[ledPercentIndicator]))
+      {
+         ledPercentIndicator++;
+      }
+      /* rising above the previous threshold */
+      while((ledPercentIndicator > LED_FULL) && (ubatChannel >= (thresholds[ledPercentIndicator - 1] + cellHysteresis[ledPercentIndicator - 1])))
+      {
+         ledPercentIndicator--;
+      }
+   }
+
+   return ledPercentIndicator;
+}
+
+void showLedStatus(ledPercentIndicatorType led)
+{
+   static uint16 strobeCycles = 0;
+   displayModeType displayMode = indicator_displayMode();
+   uint8 mask;
+
+   if(led < LED_INVALID)
+   {
+      /* bit 0 is the top segment, bit 4 stays lit down to 20% */
+      if(displayMode == DISPLAY_MODE_DOT)
+      {
+         mask = (uint8)(1 << led);
+      }
+      else
+      {
+         mask = (uint8)((0x1F << led) & 0x1F);
+      }
+
+      if(displayMode == DISPLAY_MODE_STROBE)
+      {
+         if(strobeCycles == 0)
+         {
+            hal_writeLeds(mask);
+            hal_delayMs(DISPLAY_STROBE_ON_MS);
+            strobeCycles = DISPLAY_STROBE_CYCLES;
+         }
+         strobeCycles--;
+         mask = 0x00;
+      }
+   }
+   else if(led == LED_INVALID)
+   {
+#if (INDICATOR_INVALID_BLINK == STD_ON)
+      static uint8 blink = 0;
+      mask = (uint8)((blink % 2 == 0) ? 0x01 : 0x00);
+      blink++;
+#else
+      mask = 0x15;
+#endif
+   }
+   else
+   {
+      mask = 0x00;
+   }
+   hal_writeLeds(mask);
+}
+
+/* returns TRUE if the display may go dark: the level and the raw battery value did
+ * not change for DISPLAY_AUTO_OFF_S. any change wakes the display up again.
+ */
+boolean checkDisplayIdle(ledPercentIndicatorType led, uint16 ubatChannel)
+{
+   static ledPercentIndicatorType referenceLed = LED_INVALID;
+   static uint16 referenceChannel = 0;
+   static uint16 stableCycles = 0;
+
+   if((DISPLAY_AUTO_OFF_CYCLES == 0) || (led == LED_INVALID))
+   {
+      stableCycles = 0;
+   }
+   else if((led != referenceLed) || !(in_between(ubatChannel, referenceChannel, DISPLAY_WAKE_DIGITS)))
+   {
+      referenceLed = led;
+      referenceChannel = ubatChannel;
+      stableCycles = 0;
+   }
+   else if(stableCycles < DISPLAY_AUTO_OFF_CYCLES)
+   {
+      stableCycles++;
+   }
+   else
+   {
+      /* already dark */
+   }
+
+   return (boolean)((DISPLAY_AUTO_OFF_CYCLES != 0) && (stableCycles >= DISPLAY_AUTO_OFF_CYCLES));
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+
+/* ************************************ E O F *************************************************** */
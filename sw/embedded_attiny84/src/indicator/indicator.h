@@ -0,0 +1,166 @@
+/* *************************************************************************************************
+ * file:        indicator.h
+ *
+ *          The indicator module header, the decisions behind the led bar.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, moved out of main.c of both targets
+ *          19.10.2026  agent led currents marked as calculated
+ *          19.10.2026  agent unmeasured led currents removed, kept as open item
+ *          19.10.2026  agent switch windows cut half way to their neighbours, DIGIT_DIFF 7
+ *          19.10.2026  agent hysteresis per threshold with a floor in digits
+ *
+ * notes:
+ *          decoding of the cell switch, cell count detection, the level with its hysteresis
+ *          and the led patterns. the module touches no register, inputs are adc digits and
+ *          the leds are written through hal/hal.h, so it builds for the host too (sw/host).
+ *          the differences between the targets are in indicator_cfg.h.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _INDICATOR_H_
+#define _INDICATOR_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+#include "indicator_cfg.h"
+#if (INDICATOR_SETTINGS == STD_ON)
+#include "../settings/settings.h"
+#endif
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define DIGIT_DIFF 7
+#define in_between(x, y, z) (x > (y - z)) && (x < (y + z))
+/* the open window y +- DIGIT_DIFF of a switch position, cut half way to the codes of the
+ * positions below and above. the code right in the middle of two belongs to neither.
+ */
+#define in_switch_window(x, below, y, above) (in_between(x, y, DIGIT_DIFF) && ((2 * (x)) > ((below) + (y))) && ((2 * (x)) < ((y) + (above))))
+#define ADC_DIGITS (4095)
+#define ADC_REF_VOLTAGE (5.0)
+#define UBAT_DIVIDER (34.8)
+#define ubat_volt_to_digit(x) ((uint16)(((x) * ADC_DIGITS) / (ADC_REF_VOLTAGE * UBAT_DIVIDER)))
+#define UBAT_MILLIVOLT_SCALE ((uint32)(ADC_REF_VOLTAGE * UBAT_DIVIDER * 1000))
+#define ubat_digit_to_millivolt(x) ((uint16)(((uint32)(x) * UBAT_MILLIVOLT_SCALE) / ADC_DIGITS))
+#define ubat_millivolt_to_digit(x) ((uint16)(((uint32)(x) * ADC_DIGITS) / UBAT_MILLIVOLT_SCALE))
+
+#define SWITCH_DEBOUNCE_SAMPLES     (3U)     /* equal switch decodes needed for a change */
+
+#define CELL_DETECTION_SAMPLES      (4U)     /* equal detections needed to latch the cell count */
+#define CELL_DETECTION_MARGIN_MV    (50U)    /* per cell above full, for packs fresh off the charger */
+#define MAX_NUM_OF_CELLS            (6U)
+
+#define NUM_OF_THRESHOLDS           (4U)
+
+/* hysteresis band around a threshold t in ADC digits, 1.2% of t (about 50mV per cell), but
+ * at least HYSTERESIS_MIN_DIGITS. a digit is about 42mV of the pack, for 1 to 3 cells the
+ * floor decides.
+ */
+#define HYSTERESIS_PERMILLE         (12U)
+#define HYSTERESIS_MIN_DIGITS       (4U)
+#define hysteresis_digits(t) ((uint8)((((uint32)(t) * HYSTERESIS_PERMILLE) / 1000U) > HYSTERESIS_MIN_DIGITS ? \
+                                      (((uint32)(t) * HYSTERESIS_PERMILLE) / 1000U) : HYSTERESIS_MIN_DIGITS))
+
+/* display modes. the average current of each mode is still open, it has to be measured
+ * on a board before the modes can be compared by current (doc/open_items.md).
+ *
+ *   DISPLAY_MODE_BAR     all segments up to the level
+ *   DISPLAY_MODE_DOT     only the highest segment
+ *   DISPLAY_MODE_STROBE  bar for 20ms every 3s
+ *   auto-off             dark after 30s stable, until the voltage changes
+ */
+#define DISPLAY_STROBE_ON_MS        (20U)
+#define DISPLAY_STROBE_PERIOD_S     (3U)
+#define DISPLAY_AUTO_OFF_S          (30U)    /* 0 disables auto-off */
+#define DISPLAY_WAKE_DIGITS         (4)      /* ubat change that wakes the display */
+
+/* where the tunable values come from, the settings or indicator_cfg.h */
+#if (INDICATOR_SETTINGS == STD_ON)
+#define indicator_cycleMilliSeconds()       (settings_get()->cycleMilliSeconds_ui16)
+#define indicator_displayMode()             ((displayModeType)settings_get()->displayMode_ui8)
+#define indicator_thresholdPercent(level)   (settings_get()->thresholdPercent_aui8[level])
+#define indicator_revision()                (settings_getRevision())
+#else
+#define indicator_cycleMilliSeconds()       (INDICATOR_CYCLE_MS)
+#define indicator_displayMode()             (INDICATOR_DISPLAY_MODE)
+#define indicator_thresholdPercent(level)   (indicator_thresholdPercent_aui8[level])
+#define indicator_revision()                (0U)
+#endif
+
+/* the display timings follow the duration of one main loop cycle */
+#define display_cycles(s)           ((uint16)(((uint32)(s) * 1000U) / indicator_cycleMilliSeconds()))
+#define DISPLAY_STROBE_CYCLES       display_cycles(DISPLAY_STROBE_PERIOD_S)
+#define DISPLAY_AUTO_OFF_CYCLES     display_cycles(DISPLAY_AUTO_OFF_S)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef enum
+{
+   LIPO_CELL_1 = 358,
+   LIPO_CELL_2 = 494,
+   LIPO_CELL_3 = 572,
+   LIPO_CELL_4 = 607,
+   LIPO_CELL_5 = 638,
+   LIPO_CELL_6 = 650,
+   LIPO_CELL_BELOW_1 = LIPO_CELL_1 - 2 * DIGIT_DIFF,   /* no neighbour, the cut falls on the window end */
+   LIPO_CELL_ABOVE_6 = LIPO_CELL_6 + 2 * DIGIT_DIFF,
+   LIPO_CELL_NONE = 0
+}lipoCellDigitsType;
+
+typedef enum
+{
+   SWITCH_CELL_NONE = 0,
+   SWITCH_CELL_1,
+   SWITCH_CELL_2,
+   SWITCH_CELL_3,
+   SWITCH_CELL_4,
+   SWITCH_CELL_5,
+   SWITCH_CELL_6,
+}lipoCellSwitchType;
+
+typedef enum
+{
+   LED_FULL             = 0,
+   LED_UNDER_80_PERCENT = 1,
+   LED_UNDER_60_PERCENT = 2,
+   LED_UNDER_40_PERCENT = 3,
+   LED_UNDER_20_PERCENT = 4,
+   LED_INVALID          = 5,
+   LED_OFF              = 6
+}ledPercentIndicatorType;
+
+typedef enum
+{
+   DISPLAY_MODE_BAR = 0,
+   DISPLAY_MODE_DOT,
+   DISPLAY_MODE_STROBE
+}displayModeType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+#if (INDICATOR_SETTINGS == STD_OFF)
+extern const uint8 indicator_thresholdPercent_aui8[NUM_OF_THRESHOLDS];
+#endif
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+lipoCellSwitchType checkLipoSwitch(uint16 adc_channel);
+lipoCellSwitchType debounceLipoSwitch(lipoCellSwitchType lipoSwitch);
+lipoCellSwitchType detectLipoCells(uint16 ubatMilliVolt);
+lipoCellSwitchType latchLipoCells(lipoCellSwitchType detectedCells);
+void setCellThresholds(lipoCellSwitchType cells);
+ledPercentIndicatorType checkUbatState(lipoCellSwitchType cells, uint16 ubatChannel);
+void showLedStatus(ledPercentIndicatorType led);
+boolean checkDisplayIdle(ledPercentIndicatorType led, uint16 ubatChannel);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _INDICATOR_H_ */
@@ -0,0 +1,40 @@
+/* *************************************************************************************************
+ * file:        indicator_cfg.h
+ *
+ *          The indicator module configuration of the ATtiny84 board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _INDICATOR_CFG_H_
+#define _INDICATOR_CFG_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define CELL_DETECTION_AUTO         STD_ON   /* STD_OFF: cell count from the switch only */
+
+/* STD_OFF: the tunable values are fixed below, there is no uart to change them */
+#define INDICATOR_SETTINGS          STD_OFF
+
+#define INDICATOR_THRESHOLDS        {80U, 60U, 40U, 20U}
+#define INDICATOR_DISPLAY_MODE      DISPLAY_MODE_DOT
+#define INDICATOR_CYCLE_MS          (500U)   /* duration of one main loop cycle */
+
+/* STD_ON: an invalid reading blinks the top segment, STD_OFF: every other segment is lit */
+#define INDICATOR_INVALID_BLINK     STD_OFF
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _INDICATOR_CFG_H_ */
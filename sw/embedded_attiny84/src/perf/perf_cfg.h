@@ -0,0 +1,30 @@
+/* *************************************************************************************************
+ * file:        perf_cfg.h
+ *
+ *          The performance counter module configuration of the ATtiny84 board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the attiny84 has no uart to report them on, the counters are empty.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _PERF_CFG_H_
+#define _PERF_CFG_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define PERF_MODE                   STD_OFF
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _PERF_CFG_H_ */
@@ -0,0 +1,79 @@
+/* *************************************************************************************************
+ * file:        soc.h
+ *
+ *          The state of charge module header.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent add chemistry profiles, selection stored in eeprom
+ *          19.10.2026  agent lowest cell voltage of the cell count detection per profile
+ *
+ * notes:
+ *          the state of charge is read from a piecewise linear discharge curve of one cell.
+ *          each chemistry has its own profile and curve in flash, see soc_lcfg.c.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _SOC_H_
+#define _SOC_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "std_types.h"
+#include "soc_lcfg.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define SOC_PERCENT_EMPTY   ((uint8)0)
+#define SOC_PERCENT_FULL    ((uint8)100)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* one point of the discharge curve. points are sorted by rising voltage and percentage */
+typedef struct
+{
+    uint16  cellMilliVolt_ui16;
+    uint8   percent_ui8;
+}soc_CurvePointType;
+
+typedef enum
+{
+    SOC_CHEMISTRY_LIPO = 0U,        // 4.20V LiPo
+    SOC_CHEMISTRY_LIHV,             // 4.35V high voltage LiPo
+    SOC_CHEMISTRY_LIFEPO4,          // 3.6V LiFePO4
+    SOC_CHEMISTRY_LIION,            // 4.20V Li-ion (NMC round cells)
+    SOC_CHEMISTRY_COUNT
+}soc_ChemistryType;
+
+/* cell voltages of one chemistry and its discharge curve */
+typedef struct
+{
+    uint16                      fullMilliVolt_ui16;
+    uint16                      nominalMilliVolt_ui16;
+    uint16                      emptyMilliVolt_ui16;
+    uint16                      detectMilliVolt_ui16;   // lowest cell voltage the cell count is detected at
+    const soc_CurvePointType   *points_ps;
+    uint8                       numberOfPoints_ui8;
+}soc_ProfileType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void soc_init(void);
+void soc_setChemistry(soc_ChemistryType chemistry_e);
+soc_ChemistryType soc_getChemistry(void);
+const soc_ProfileType *soc_getProfile(void);
+uint8 soc_getPercent(uint16 cellMilliVolt_ui16);
+uint16 soc_getCellMilliVolt(uint8 percent_ui8);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _SOC_H_ */
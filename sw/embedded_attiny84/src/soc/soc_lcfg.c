@@ -0,0 +1,105 @@
+/* *************************************************************************************************
+ * file:        soc_lcfg.c
+ *
+ *          The state of charge module linktime configuration.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent profile table for LiPo, LiHV, LiFePO4 and Li-ion
+ *          19.10.2026  agent LiFePO4 full at the end of its curve, detection floor per profile
+ *
+ * notes:
+ *          the curves are resting voltages of one cell. the profiles and points are read
+ *          with pgm_read_*, so both tables must stay in PROGMEM. the profile table is
+ *          indexed with soc_ChemistryType.
+ *          full is the end of the curve, the voltage of a rested full cell.
+ *
+ *          the cell count detection of indicator.c takes cells * [detect, full + margin] as
+ *          the window of a pack. the windows of 1 to 6 cells only stay apart if detect is
+ *          above 5/6 of full + margin, 50mV of margin give these floors:
+ *
+ *              chemistry   detect   6 * detect   5 * (full + margin)   state of charge
+ *              LiPo        3550mV   21300mV      21250mV               about 3%
+ *              LiHV        3670mV   22020mV      22000mV               about 3%
+ *              LiFePO4     2880mV   17280mV      17250mV               about 7%
+ *              Li-ion      3550mV   21300mV      21250mV               about 20%
+ *
+ *          so all of 1 to 6 cells are detected for every chemistry. a pack below the floor,
+ *          a Li-ion pack below a fifth of its charge e.g., is not detected and the switch
+ *          gives the cell count. so does a cell fresh off the charger above full + margin
+ *          until it has rested.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include <avr/pgmspace.h>
+#include "soc.h"
+#include "soc_lcfg.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define SOC_CURVE(c)    (c), (uint8)(sizeof(c) / sizeof((c)[0]))
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static const soc_CurvePointType soc_lipoCurve_as[] PROGMEM =
+{
+        {3270,   0}, {3610,   5}, {3690,  10}, {3710,  15}, {3730,  20}, {3750,  25}, {3770,  30},
+        {3790,  35}, {3800,  40}, {3820,  45}, {3840,  50}, {3850,  55}, {3870,  60}, {3910,  65},
+        {3950,  70}, {3980,  75}, {4020,  80}, {4080,  85}, {4110,  90}, {4150,  95}, {4200, 100}
+};
+
+static const soc_CurvePointType soc_lihvCurve_as[] PROGMEM =
+{
+        {3300,   0}, {3640,   5}, {3720,  10}, {3750,  15}, {3770,  20}, {3790,  25}, {3810,  30},
+        {3830,  35}, {3850,  40}, {3870,  45}, {3890,  50}, {3910,  55}, {3940,  60}, {3990,  65},
+        {4040,  70}, {4080,  75}, {4130,  80}, {4190,  85}, {4240,  90}, {4290,  95}, {4350, 100}
+};
+
+static const soc_CurvePointType soc_lifepo4Curve_as[] PROGMEM =
+{
+        {2500,   0}, {3000,   9}, {3200,  14}, {3220,  17}, {3250,  20}, {3260,  30}, {3270,  40},
+        {3300,  70}, {3320,  90}, {3350,  99}, {3400, 100}
+};
+
+static const soc_CurvePointType soc_liionCurve_as[] PROGMEM =
+{
+        {3000,   0}, {3300,   5}, {3450,  10}, {3500,  15}, {3550,  20}, {3600,  30}, {3650,  40},
+        {3700,  50}, {3750,  60}, {3800,  65}, {3850,  70}, {3900,  75}, {3950,  80}, {4000,  85},
+        {4050,  90}, {4100,  95}, {4200, 100}
+};
+
+static const soc_ProfileType soc_profiles_as[SOC_CHEMISTRY_COUNT] PROGMEM =
+{
+        /* full, nominal, empty, detect, curve */
+        {4200, 3700, 3270, 3550, SOC_CURVE(soc_lipoCurve_as)},       // SOC_CHEMISTRY_LIPO
+        {4350, 3800, 3300, 3670, SOC_CURVE(soc_lihvCurve_as)},       // SOC_CHEMISTRY_LIHV
+        {3400, 3200, 2500, 2880, SOC_CURVE(soc_lifepo4Curve_as)},    // SOC_CHEMISTRY_LIFEPO4
+        {4200, 3600, 3000, 3550, SOC_CURVE(soc_liionCurve_as)}       // SOC_CHEMISTRY_LIION
+};
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+const void *soc_getLcfgData(void)
+{
+   return ((const void*) soc_profiles_as);
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* ************************************ E O F *************************************************** */
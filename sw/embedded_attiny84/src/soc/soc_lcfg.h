@@ -0,0 +1,36 @@
+/* *************************************************************************************************
+ * file:        soc_lcfg.h
+ *
+ *          The state of charge module linktime configuration header.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _SOC_LCFG_H_
+#define _SOC_LCFG_H_
+/* ============================================================================================== */
+
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+const void *soc_getLcfgData(void);
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _SOC_LCFG_H_ */
@@ -0,0 +1,78 @@
+/* *************************************************************************************************
+ * file:        stack.c
+ *
+ *          The stack module, high-water mark of the stack and sram usage.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent marked as not run yet
+ *          19.10.2026  agent painting in c from main(), no naked code in .init1
+ *
+ * notes:
+ *          _end and __stack come from the linker script of avr-libc: the first byte after
+ *          .bss and RAMEND. stack_paint() is plain c and is called first thing in main(), the
+ *          startup code has set up r1 and the stack pointer by then. it paints up to
+ *          STACK_PAINT_GUARD bytes below its own stack pointer, so the frames of main() and
+ *          of the call stay untouched. they count as used from the start, the high-water mark
+ *          errs on the safe side by that much. neither function has run on a board yet.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/io.h>
+#include "stack.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+extern uint8 _end;
+extern uint8 __stack;
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+/* fills _end up to STACK_PAINT_GUARD bytes below the stack pointer with STACK_PAINT. call it
+ * before sei(), the mark of an interrupt in between could be painted over.
+ */
+void stack_paint(void)
+{
+    uint8 *byte_pui8 = &_end;
+    const uint8 *top_pui8 = (const uint8 *)(SP - STACK_PAINT_GUARD);
+
+    while (byte_pui8 < top_pui8)
+    {
+        *byte_pui8++ = STACK_PAINT;
+    }
+}
+
+void stack_getUsage(stack_UsageType *usage_ps)
+{
+    const uint8 *byte_pui8 = &_end;
+
+    while ((byte_pui8 <= &__stack) && (*byte_pui8 == STACK_PAINT))
+    {
+        byte_pui8++;
+    }
+
+    usage_ps->staticBytes_ui16 = (uint16)(&_end - (const uint8 *)RAMSTART);
+    usage_ps->freeBytes_ui16 = (uint16)(byte_pui8 - &_end);
+    usage_ps->stackMaxBytes_ui16 = (uint16)(&__stack - byte_pui8 + 1);
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,204 @@
+/* *************************************************************************************************
+ * file:        stats.c
+ *
+ *          The statistics module, usage counters kept in the internal eeprom.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent performance counters
+ *          19.10.2026  agent saved minimum starts at the first sample, averaged voltage
+ *
+ * notes:
+ *          an eeprom byte takes 3.3ms and wears out, so the record lives in ram and is only
+ *          saved on power on, on a meaningful change (see stats.h) or by stats_save() before
+ *          the display goes dark. writing the record on every change of a value would be
+ *          the naive way, both counts are kept and the difference is the saved writes.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <stddef.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include "stats.h"
+#include "../perf/perf.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* everything in front of the crc, a padded struct of the host has bytes behind it */
+#define STATS_CRC_LENGTH    (offsetof(stats_RecordType, crc_ui16))
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static stats_RecordType stats_slotsEeprom_as[STATS_NUM_OF_SLOTS] EEMEM;
+
+static stats_RecordType stats_record_s;
+static uint8  stats_slot_ui8;                   // slot of the last save
+static uint32 stats_savedRuntime_ui32;
+static uint16 stats_savedMinMilliVolt_ui16;
+static uint16 stats_milliSeconds_ui16;          // below one second, not counted yet
+static uint32 stats_filtered_ui32;              // pack voltage << STATS_FILTER_SHIFT, 0 before the first sample
+static boolean stats_dirty_b;
+
+static uint16 stats_naiveWrites_ui16;
+static uint16 stats_writes_ui16;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static uint16 stats_crc(const stats_RecordType *record_ps);
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+/* loads the newest valid slot and counts the power on */
+void stats_init(void)
+{
+    stats_RecordType slot_s;
+    boolean found_b = FALSE;
+    uint8 slot_ui8;
+
+    for (slot_ui8 = 0; slot_ui8 < STATS_NUM_OF_SLOTS; slot_ui8++)
+    {
+        eeprom_read_block(&slot_s, &stats_slotsEeprom_as[slot_ui8], sizeof(slot_s));
+        if ((slot_s.crc_ui16 == stats_crc(&slot_s)) &&
+            ((found_b == FALSE) || ((sint16)(slot_s.sequence_ui16 - stats_record_s.sequence_ui16) > 0)))
+        {
+            stats_record_s = slot_s;
+            stats_slot_ui8 = slot_ui8;
+            found_b = TRUE;
+        }
+    }
+
+    if (found_b == FALSE)
+    {
+        stats_record_s.sequence_ui16 = 0;
+        stats_record_s.powerOnCount_ui16 = 0;
+        stats_record_s.runtimeSeconds_ui32 = 0;
+        stats_record_s.lowSeconds_ui32 = 0;
+        stats_record_s.sessionMinMilliVolt_ui16 = STATS_NO_VOLTAGE;
+        stats_slot_ui8 = STATS_NUM_OF_SLOTS - 1U;
+    }
+
+    stats_record_s.powerOnCount_ui16++;
+    stats_record_s.lastSessionMinMilliVolt_ui16 = stats_record_s.sessionMinMilliVolt_ui16;
+    stats_record_s.sessionMinMilliVolt_ui16 = STATS_NO_VOLTAGE;
+    stats_milliSeconds_ui16 = 0;
+    stats_filtered_ui32 = 0;
+    stats_naiveWrites_ui16 = 0;
+    stats_writes_ui16 = 0;
+
+    stats_dirty_b = TRUE;
+    stats_save();
+}
+
+void stats_update(uint16 packMilliVolt_ui16, uint8 socPercent_ui8, uint16 elapsedMilliSeconds_ui16)
+{
+    boolean changed_b = FALSE;
+    uint16 seconds_ui16;
+    uint16 filtered_ui16;
+
+    stats_milliSeconds_ui16 += elapsedMilliSeconds_ui16;
+    seconds_ui16 = stats_milliSeconds_ui16 / 1000U;
+    stats_milliSeconds_ui16 %= 1000U;
+
+    if (seconds_ui16 != 0)
+    {
+        stats_record_s.runtimeSeconds_ui32 += seconds_ui16;
+        if (socPercent_ui8 < STATS_LOW_PERCENT)
+        {
+            stats_record_s.lowSeconds_ui32 += seconds_ui16;
+        }
+        changed_b = TRUE;
+    }
+    if (stats_filtered_ui32 == 0U)
+    {
+        /* the first sample of the session is its minimum so far, no save is due for it */
+        stats_filtered_ui32 = (uint32)packMilliVolt_ui16 << STATS_FILTER_SHIFT;
+        stats_savedMinMilliVolt_ui16 = packMilliVolt_ui16;
+    }
+    else
+    {
+        stats_filtered_ui32 = stats_filtered_ui32 - (stats_filtered_ui32 >> STATS_FILTER_SHIFT) + packMilliVolt_ui16;
+    }
+    filtered_ui16 = (uint16)(stats_filtered_ui32 >> STATS_FILTER_SHIFT);
+
+    if (filtered_ui16 < stats_record_s.sessionMinMilliVolt_ui16)
+    {
+        stats_record_s.sessionMinMilliVolt_ui16 = filtered_ui16;
+        changed_b = TRUE;
+    }
+
+    if (changed_b == TRUE)
+    {
+        stats_naiveWrites_ui16++;
+        stats_dirty_b = TRUE;
+    }
+
+    if (((stats_record_s.runtimeSeconds_ui32 - stats_savedRuntime_ui32) >= STATS_SAVE_INTERVAL_S) ||
+        ((uint16)(stats_savedMinMilliVolt_ui16 - stats_record_s.sessionMinMilliVolt_ui16) >= STATS_SAVE_STEP_MV))
+    {
+        stats_save();
+    }
+}
+
+/* writes the record to the next slot if anything changed since the last save */
+void stats_save(void)
+{
+    if (stats_dirty_b == FALSE)
+    {
+        return;
+    }
+
+    stats_slot_ui8 = (uint8)((stats_slot_ui8 + 1U) % STATS_NUM_OF_SLOTS);
+    stats_record_s.sequence_ui16++;
+    stats_record_s.crc_ui16 = stats_crc(&stats_record_s);
+
+    /* only the bytes that differ from the old content of the slot are programmed */
+    perf_count(eepromWrites_ui16);
+    eeprom_update_block(&stats_record_s, &stats_slotsEeprom_as[stats_slot_ui8], sizeof(stats_record_s));
+
+    stats_savedRuntime_ui32 = stats_record_s.runtimeSeconds_ui32;
+    stats_savedMinMilliVolt_ui16 = stats_record_s.sessionMinMilliVolt_ui16;
+    stats_dirty_b = FALSE;
+    stats_writes_ui16++;
+}
+
+const stats_RecordType *stats_get(void)
+{
+    return &stats_record_s;
+}
+
+/* record writes avoided since power on compared to saving every change */
+uint16 stats_getSavedWrites(void)
+{
+    return (stats_naiveWrites_ui16 > stats_writes_ui16) ? (uint16)(stats_naiveWrites_ui16 - stats_writes_ui16) : 0U;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+static uint16 stats_crc(const stats_RecordType *record_ps)
+{
+    const uint8 *data_pui8 = (const uint8 *)record_ps;
+    uint16 crc_ui16 = 0xFFFFU;
+    uint8 byte_ui8;
+
+    for (byte_ui8 = 0; byte_ui8 < STATS_CRC_LENGTH; byte_ui8++)
+    {
+        crc_ui16 = _crc16_update(crc_ui16, data_pui8[byte_ui8]);
+    }
+    return crc_ui16;
+}
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,74 @@
+/* *************************************************************************************************
+ * file:        stats.h
+ *
+ *          The statistics module header, usage counters kept in the internal eeprom.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent minimum of the averaged pack voltage
+ *
+ * notes:
+ *          the record is written to a ring of STATS_NUM_OF_SLOTS slots, every save takes the
+ *          next slot. a crc protects every slot, the valid slot with the highest sequence is
+ *          the current one. a slot survives about 100000 writes, the ring multiplies that.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _STATS_H_
+#define _STATS_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define STATS_NUM_OF_SLOTS          (8U)
+
+/* a save is due if the runtime grew this much or the session minimum fell this much */
+#define STATS_SAVE_INTERVAL_S       (600UL)
+#define STATS_SAVE_STEP_MV          (100U)
+
+/* the pack voltage is averaged over about 2^STATS_FILTER_SHIFT updates before it counts as
+ * minimum, so a short dip under load neither lowers it nor causes a save
+ */
+#define STATS_FILTER_SHIFT          (4U)
+
+/* time below this state of charge is counted */
+#define STATS_LOW_PERCENT           (20U)
+
+#define STATS_NO_VOLTAGE            (0xFFFFU)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    uint16  sequence_ui16;
+    uint16  powerOnCount_ui16;
+    uint32  runtimeSeconds_ui32;
+    uint32  lowSeconds_ui32;                    // time below STATS_LOW_PERCENT
+    uint16  sessionMinMilliVolt_ui16;           // lowest averaged pack voltage since power on
+    uint16  lastSessionMinMilliVolt_ui16;       // the same for the session before
+    uint16  crc_ui16;
+}stats_RecordType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void stats_init(void);
+void stats_update(uint16 packMilliVolt_ui16, uint8 socPercent_ui8, uint16 elapsedMilliSeconds_ui16);
+void stats_save(void);
+const stats_RecordType *stats_get(void);
+uint16 stats_getSavedWrites(void);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _STATS_H_ */
@@ -0,0 +1,110 @@
+/* *************************************************************************************************
+ * file:        trace.h
+ *
+ *          The trace module header, timestamped events in a ram ring.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          an entry is the event id, a timestamp and a payload, 5 bytes. the ring keeps the
+ *          last TRACE_SIZE entries and goes out with "dump", sw/tools/trace2json.py turns it
+ *          into a timeline or a chrome trace.
+ *
+ *          timestamp: the low byte of the 1ms tick in the high byte and the counter of timer0
+ *          in the low byte, TIMER_PRESCALER / F_CPU per count (4us at 16MHz). it wraps after
+ *          256ms, the host unwraps it as long as no gap between two entries is longer.
+ *
+ *          an event id holds its group in the high nibble. only the groups set in the mask
+ *          are recorded, the uart and interrupt groups are off by default because they fill
+ *          the ring with every status line. the tick interrupt is never traced, it would fill
+ *          the ring every TRACE_SIZE / 2 ms.
+ *
+ *          with TRACE_MODE STD_OFF in trace_cfg.h the trace points compile to nothing and
+ *          trace.c is not needed, this header is shared with the targets without a uart.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _TRACE_H_
+#define _TRACE_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "../../inc/std_types.h"
+#include "trace_cfg.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* bits of the mask, bit n records the events 0xn1..0xnF */
+#define TRACE_GROUP_ADC             (1U << 0)
+#define TRACE_GROUP_LED             (1U << 1)
+#define TRACE_GROUP_UART            (1U << 2)
+#define TRACE_GROUP_SCHEDULER       (1U << 3)
+#define TRACE_GROUP_ISR             (1U << 4)
+#define TRACE_GROUP_ALL             (0x1FU)
+
+#define trace_group(event)          ((uint8)((uint8)(event) >> 4))
+
+#if (TRACE_MODE == STD_OFF)
+#define trace_event(event, payload) ((void)0)
+#endif
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* keep EVENTS of sw/tools/trace2json.py in sync */
+typedef enum
+{
+    TRACE_ADC_START     = 0x01U,    // payload: channel
+    TRACE_ADC_DONE      = 0x02U,    // payload: 10 bit result
+    TRACE_LED           = 0x11U,    // payload: new led mask, only written on a change
+    TRACE_UART_TX       = 0x21U,    // payload: first byte after the transmitter was idle
+    TRACE_UART_LINE     = 0x22U,    // payload: length of a received line
+    TRACE_LOOP          = 0x31U,    // payload: number of the main loop cycle
+    TRACE_COMMAND       = 0x32U,    // payload: index in the command table
+    TRACE_ISR_ENTRY     = 0x41U,    // payload: trace_IsrType
+    TRACE_ISR_EXIT      = 0x42U     // payload: trace_IsrType
+}trace_EventType;
+
+typedef enum
+{
+    TRACE_ISR_UART_RX = 0U,
+    TRACE_ISR_UART_UDRE,
+    TRACE_ISR_TWI,
+    TRACE_ISR_ADC
+}trace_IsrType;
+
+typedef struct
+{
+    uint8   event_ui8;
+    uint16  stamp_ui16;
+    uint16  payload_ui16;
+}trace_EntryType;
+
+/* sent as it is by the dump, entries oldest first start at head - count */
+typedef struct
+{
+    trace_EntryType entries_as[TRACE_SIZE];
+    uint8           head_ui8;
+    uint8           count_ui8;
+}trace_RingType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+#if (TRACE_MODE == STD_ON)
+void trace_event(trace_EventType event_e, uint16 payload_ui16);
+uint8 trace_setMask(uint8 mask_ui8);
+const trace_RingType *trace_get(void);
+#endif
+
+/* ************************************ E O F *************************************************** */
+#endif /* _TRACE_H_ */
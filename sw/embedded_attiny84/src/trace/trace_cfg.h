@@ -0,0 +1,32 @@
+/* *************************************************************************************************
+ * file:        trace_cfg.h
+ *
+ *          The trace module configuration of the ATtiny84 board.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          no uart to dump the ring and no sram to spare, the trace points are empty.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _TRACE_CFG_H_
+#define _TRACE_CFG_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define TRACE_MODE                  STD_OFF
+
+#define TRACE_SIZE                  (1U)
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _TRACE_CFG_H_ */
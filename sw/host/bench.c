@@ -0,0 +1,205 @@
+/* *************************************************************************************************
+ * file:        bench.c
+ *
+ *          Host benchmark of the indicator core, built once per target by the Makefile.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          runs every case BENCH_CALLS times on the host cpu and prints one line per case:
+ *              <target> <case> <calls> <ns per call>
+ *          the numbers compare algorithms and catch regressions, they are no avr cycles.
+ *          "cycle" is the decision part of one main loop cycle of the attiny84 firmware.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "hal_host.h"
+#include "indicator/indicator.h"
+#include "soc/soc.h"
+#include "history/history.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define BENCH_CALLS                 (1000000UL)
+
+/* 10 bit codes */
+#define BENCH_CODES                 (1024U)
+
+/* a 3 cell pack from 12.6V down to 9.0V in adc digits */
+#define BENCH_UBAT_FULL             ubat_millivolt_to_digit(12600U)
+#define BENCH_UBAT_EMPTY            ubat_millivolt_to_digit(9000U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    const char  *name_pc;
+    void        (*run_pf)(uint32 call_ui32);
+}bench_CaseType;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static uint16 bench_ubat(uint32 call_ui32);
+static void bench_checkLipoSwitch(uint32 call_ui32);
+static void bench_debounceLipoSwitch(uint32 call_ui32);
+static void bench_detectLipoCells(uint32 call_ui32);
+static void bench_checkUbatState(uint32 call_ui32);
+static void bench_checkUbatStateCellChange(uint32 call_ui32);
+static void bench_showLedStatus(uint32 call_ui32);
+static void bench_checkDisplayIdle(uint32 call_ui32);
+static void bench_socGetPercent(uint32 call_ui32);
+static void bench_historyAdd(uint32 call_ui32);
+static void bench_cycle(uint32 call_ui32);
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+/* keeps the compiler from dropping the results */
+static volatile uint32 bench_sink_ui32;
+
+static const bench_CaseType bench_cases_as[] =
+{
+    { "checkLipoSwitch",                bench_checkLipoSwitch },
+    { "debounceLipoSwitch",             bench_debounceLipoSwitch },
+    { "detectLipoCells",                bench_detectLipoCells },
+    { "checkUbatState",                 bench_checkUbatState },
+    { "checkUbatState_cellChange",      bench_checkUbatStateCellChange },
+    { "showLedStatus",                  bench_showLedStatus },
+    { "checkDisplayIdle",               bench_checkDisplayIdle },
+    { "soc_getPercent",                 bench_socGetPercent },
+    { "history_add",                    bench_historyAdd },
+    { "cycle",                          bench_cycle },
+};
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+int main(void)
+{
+    struct timespec start_s;
+    struct timespec end_s;
+    double nanoSeconds_f64;
+    uint32 call_ui32;
+    uint8 case_ui8;
+
+    hal_init();
+    soc_init();
+#if (INDICATOR_SETTINGS == STD_ON)
+    settings_init();
+#endif
+    history_init();
+
+    for (case_ui8 = 0; case_ui8 < (sizeof(bench_cases_as) / sizeof(bench_cases_as[0])); case_ui8++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start_s);
+        for (call_ui32 = 0; call_ui32 < BENCH_CALLS; call_ui32++)
+        {
+            bench_cases_as[case_ui8].run_pf(call_ui32);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end_s);
+
+        nanoSeconds_f64 = ((double)(end_s.tv_sec - start_s.tv_sec) * 1e9) + (double)(end_s.tv_nsec - start_s.tv_nsec);
+        printf("%s %s %lu %.2f\n", BENCH_TARGET, bench_cases_as[case_ui8].name_pc, BENCH_CALLS, nanoSeconds_f64 / (double)BENCH_CALLS);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* a slow triangle between full and empty */
+static uint16 bench_ubat(uint32 call_ui32)
+{
+    uint32 span_ui32 = BENCH_UBAT_FULL - BENCH_UBAT_EMPTY;
+    uint32 phase_ui32 = (call_ui32 / 64U) % (2U * span_ui32);
+
+    return (uint16)(BENCH_UBAT_EMPTY + ((phase_ui32 < span_ui32) ? phase_ui32 : ((2U * span_ui32) - phase_ui32)));
+}
+
+static void bench_checkLipoSwitch(uint32 call_ui32)
+{
+    bench_sink_ui32 += checkLipoSwitch((uint16)(call_ui32 % BENCH_CODES));
+}
+
+static void bench_debounceLipoSwitch(uint32 call_ui32)
+{
+    bench_sink_ui32 += debounceLipoSwitch(checkLipoSwitch((uint16)((call_ui32 / 4U) % BENCH_CODES)));
+}
+
+static void bench_detectLipoCells(uint32 call_ui32)
+{
+    bench_sink_ui32 += detectLipoCells(ubat_digit_to_millivolt(call_ui32 % BENCH_CODES));
+}
+
+static void bench_checkUbatState(uint32 call_ui32)
+{
+    bench_sink_ui32 += checkUbatState(SWITCH_CELL_3, bench_ubat(call_ui32));
+}
+
+/* every call recomputes the thresholds */
+static void bench_checkUbatStateCellChange(uint32 call_ui32)
+{
+    bench_sink_ui32 += checkUbatState((lipoCellSwitchType)(SWITCH_CELL_1 + (call_ui32 % MAX_NUM_OF_CELLS)), bench_ubat(call_ui32));
+}
+
+static void bench_showLedStatus(uint32 call_ui32)
+{
+    showLedStatus((ledPercentIndicatorType)(call_ui32 % (LED_OFF + 1U)));
+    bench_sink_ui32 += hal_hostRegisters_s.leds_ui8;
+}
+
+static void bench_checkDisplayIdle(uint32 call_ui32)
+{
+    bench_sink_ui32 += checkDisplayIdle(LED_UNDER_40_PERCENT, bench_ubat(call_ui32));
+}
+
+static void bench_socGetPercent(uint32 call_ui32)
+{
+    bench_sink_ui32 += soc_getPercent((uint16)(3000U + (call_ui32 % 1300U)));
+}
+
+static void bench_historyAdd(uint32 call_ui32)
+{
+    history_add((uint16)(3000U + (call_ui32 % 1300U)));
+}
+
+/* the same order of calls as the main loop of the attiny84 */
+static void bench_cycle(uint32 call_ui32)
+{
+    uint16 ubatChannel_ui16;
+    lipoCellSwitchType cells_e;
+    ledPercentIndicatorType led_e = LED_INVALID;
+
+    hal_hostRegisters_s.adc_aui16[HAL_CHANNEL_UBAT] = bench_ubat(call_ui32);
+    hal_hostRegisters_s.adc_aui16[HAL_CHANNEL_SWITCH] = LIPO_CELL_3;
+
+    ubatChannel_ui16 = hal_readChannel(HAL_CHANNEL_UBAT);
+    cells_e = latchLipoCells(detectLipoCells(ubat_digit_to_millivolt(ubatChannel_ui16)));
+    if (cells_e == SWITCH_CELL_NONE)
+    {
+        cells_e = debounceLipoSwitch(checkLipoSwitch(hal_readChannel(HAL_CHANNEL_SWITCH)));
+    }
+    if (cells_e > SWITCH_CELL_NONE)
+    {
+        led_e = checkUbatState(cells_e, ubatChannel_ui16);
+        bench_sink_ui32 += soc_getPercent(ubat_digit_to_millivolt(ubatChannel_ui16) / cells_e);
+    }
+    showLedStatus((checkDisplayIdle(led_e, ubatChannel_ui16) == TRUE) ? LED_OFF : led_e);
+    bench_sink_ui32 += hal_hostRegisters_s.leds_ui8;
+}
+
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,74 @@
+/* *************************************************************************************************
+ * file:        hal_host.c
+ *
+ *          The hardware abstraction of the host build, simulated registers.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <string.h>
+#include "hal_host.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* 10 bit converter */
+#define HAL_HOST_ADC_MAX            (1023U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+hal_HostRegistersType hal_hostRegisters_s;
+
+/* counted by include/avr/eeprom.h */
+uint32_t host_eepromWrites;
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void hal_init(void)
+{
+    memset(&hal_hostRegisters_s, 0, sizeof(hal_hostRegisters_s));
+}
+
+uint16 hal_readChannel(hal_ChannelType channel_e)
+{
+    uint16 value_ui16 = hal_hostRegisters_s.adc_aui16[channel_e];
+
+    hal_hostRegisters_s.conversions_ui32++;
+    return (value_ui16 > HAL_HOST_ADC_MAX) ? HAL_HOST_ADC_MAX : value_ui16;
+}
+
+void hal_writeLeds(uint8 mask_ui8)
+{
+    hal_hostRegisters_s.leds_ui8 = (uint8)(mask_ui8 & ((1U << HAL_NUM_OF_LEDS) - 1U));
+    hal_hostRegisters_s.ledWrites_ui32++;
+}
+
+void hal_delayMs(uint16 milliSeconds_ui16)
+{
+    hal_hostRegisters_s.milliSeconds_ui32 += milliSeconds_ui16;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,52 @@
+/* *************************************************************************************************
+ * file:        hal_host.h
+ *
+ *          The hardware abstraction of the host build, simulated registers.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the caller puts the converter inputs into hal_hostRegisters_s before a cycle and
+ *          reads the led port and the counters afterwards. time does not pass by itself,
+ *          hal_delayMs() only adds to the millisecond counter.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HAL_HOST_H_
+#define _HAL_HOST_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "hal/hal.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    uint16  adc_aui16[HAL_CHANNEL_COUNT];   // input of the converter per channel
+    uint8   leds_ui8;                       // led port, bit 0 is the top segment
+    uint32  conversions_ui32;
+    uint32  ledWrites_ui32;
+    uint32  milliSeconds_ui32;              // waited in hal_delayMs()
+}hal_HostRegistersType;
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+extern hal_HostRegistersType hal_hostRegisters_s;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ************************************ E O F *************************************************** */
+#endif /* _HAL_HOST_H_ */
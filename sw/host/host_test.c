@@ -0,0 +1,72 @@
+/* *************************************************************************************************
+ * file:        host_test.c
+ *
+ *          Pass/fail checks of the host tests.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          - none -
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <stdarg.h>
+#include <stdio.h>
+#include "host_test.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static uint32 host_checks_ui32;
+static uint32 host_failures_ui32;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+void host_check(boolean condition_b, const char *file_pc, int line, const char *format_pc, ...)
+{
+    va_list args_s;
+
+    host_checks_ui32++;
+    if (condition_b == TRUE)
+    {
+        return;
+    }
+    if (host_failures_ui32 < HOST_TEST_MAX_PRINTED)
+    {
+        va_start(args_s, format_pc);
+        fprintf(stderr, "%s: %s:%d: ", BENCH_TARGET, file_pc, line);
+        vfprintf(stderr, format_pc, args_s);
+        fprintf(stderr, "\n");
+        va_end(args_s);
+    }
+    host_failures_ui32++;
+}
+
+int host_testResult(const char *name_pc)
+{
+    fprintf(stderr, "%s: %s: %lu checks, %lu failed\n", BENCH_TARGET, name_pc, (unsigned long)host_checks_ui32,
+            (unsigned long)host_failures_ui32);
+    return (host_failures_ui32 == 0U) ? 0 : 1;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+
+/* ************************************ E O F *************************************************** */
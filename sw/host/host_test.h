@@ -0,0 +1,45 @@
+/* *************************************************************************************************
+ * file:        host_test.h
+ *
+ *          Pass/fail checks of the host tests, see the test_*.c files.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          host_expect() counts a failed condition and prints it with its place, the first
+ *          HOST_TEST_MAX_PRINTED of a run are printed. host_testResult() prints the summary
+ *          and returns the exit code of main(), 0 if all checks passed.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HOST_TEST_H_
+#define _HOST_TEST_H_
+/* ============================================================================================== */
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+
+#include "std_types.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define HOST_TEST_MAX_PRINTED       (20U)
+
+#define host_expect(condition, ...) host_check((boolean)((condition) ? TRUE : FALSE), __FILE__, __LINE__, __VA_ARGS__)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void host_check(boolean condition_b, const char *file_pc, int line, const char *format_pc, ...);
+int host_testResult(const char *name_pc);
+
+/* ************************************ E O F *************************************************** */
+#endif /* _HOST_TEST_H_ */
@@ -0,0 +1,58 @@
+/* *************************************************************************************************
+ * file:        eeprom.h
+ *
+ *          Host replacement of <avr/eeprom.h>, the EEMEM variables are the eeprom.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the cells start as zero instead of 0xFF, the crc of a record does not match
+ *          either way. every write is counted in host_eepromWrites.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HOST_EEPROM_H_
+#define _HOST_EEPROM_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define EEMEM
+
+extern uint32_t host_eepromWrites;
+
+static inline uint8_t eeprom_read_byte(const uint8_t *address)
+{
+    return *address;
+}
+
+static inline void eeprom_update_byte(uint8_t *address, uint8_t value)
+{
+    if (*address != value)
+    {
+        *address = value;
+        host_eepromWrites++;
+    }
+}
+
+static inline void eeprom_read_block(void *destination, const void *source, size_t length)
+{
+    memcpy(destination, source, length);
+}
+
+static inline void eeprom_update_block(const void *source, void *destination, size_t length)
+{
+    size_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        eeprom_update_byte((uint8_t *)destination + index, ((const uint8_t *)source)[index]);
+    }
+}
+
+#endif /* _HOST_EEPROM_H_ */
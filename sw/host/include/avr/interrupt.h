@@ -0,0 +1,26 @@
+/* *************************************************************************************************
+ * file:        interrupt.h
+ *
+ *          Host replacement of <avr/interrupt.h>, an interrupt is a function the test calls.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          ISR(TWI_vect) becomes void TWI_vect(void).
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HOST_INTERRUPT_H_
+#define _HOST_INTERRUPT_H_
+
+#define ISR(vector)     void vector(void); void vector(void)
+
+#define sei()           ((void)0)
+#define cli()           ((void)0)
+
+#endif /* _HOST_INTERRUPT_H_ */
@@ -0,0 +1,47 @@
+/* *************************************************************************************************
+ * file:        io.h
+ *
+ *          Host replacement of <avr/io.h>, the registers of the twi and the status register.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the registers are plain variables, the test that links twi.c defines them and
+ *          plays the hardware: it sets TWSR and calls TWI_vect(). only what twi.c, trace.c
+ *          and telemetry.c of the atmega328p use is here.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HOST_IO_H_
+#define _HOST_IO_H_
+
+#include <stdint.h>
+
+extern volatile uint8_t SREG;
+extern volatile uint8_t TWBR;
+extern volatile uint8_t TWSR;
+extern volatile uint8_t TWAR;
+extern volatile uint8_t TWDR;
+extern volatile uint8_t TWCR;
+extern volatile uint8_t PORTC;
+extern volatile uint8_t DDRC;
+extern volatile uint8_t PINC;
+
+/* TWCR */
+#define TWIE    0
+#define TWEN    2
+#define TWWC    3
+#define TWSTO   4
+#define TWSTA   5
+#define TWEA    6
+#define TWINT   7
+
+#define PC4     4
+#define PC5     5
+
+#endif /* _HOST_IO_H_ */
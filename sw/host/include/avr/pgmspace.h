@@ -0,0 +1,30 @@
+/* *************************************************************************************************
+ * file:        pgmspace.h
+ *
+ *          Host replacement of <avr/pgmspace.h>, flash is ordinary memory.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HOST_PGMSPACE_H_
+#define _HOST_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s)                 (s)
+#define pgm_read_byte(a)        (*(const uint8_t *)(a))
+#define pgm_read_word(a)        (*(const uint16_t *)(a))
+#define pgm_read_dword(a)       (*(const uint32_t *)(a))
+#define pgm_read_ptr(a)         (*(void * const *)(a))
+#define memcpy_P                memcpy
+#define strcmp_P                strcmp
+
+#endif /* _HOST_PGMSPACE_H_ */
@@ -0,0 +1,26 @@
+/* *************************************************************************************************
+ * file:        sleep.h
+ *
+ *          Host replacement of <avr/sleep.h>, the cpu never sleeps.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HOST_SLEEP_H_
+#define _HOST_SLEEP_H_
+
+#define SLEEP_MODE_IDLE         (0U)
+
+#define set_sleep_mode(mode)    ((void)(mode))
+#define sleep_enable()          ((void)0)
+#define sleep_disable()         ((void)0)
+#define sleep_cpu()             ((void)0)
+#define sleep_mode()            ((void)0)
+
+#endif /* _HOST_SLEEP_H_ */
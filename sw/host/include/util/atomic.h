@@ -0,0 +1,26 @@
+/* *************************************************************************************************
+ * file:        atomic.h
+ *
+ *          Host replacement of <util/atomic.h>, there are no interrupts to mask.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the block runs exactly once, as on the target.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HOST_ATOMIC_H_
+#define _HOST_ATOMIC_H_
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+
+#define ATOMIC_BLOCK(type)  for (int atomicOnce_i = 1; atomicOnce_i != 0; atomicOnce_i = 0)
+
+#endif /* _HOST_ATOMIC_H_ */
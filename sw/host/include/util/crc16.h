@@ -0,0 +1,46 @@
+/* *************************************************************************************************
+ * file:        crc16.h
+ *
+ *          Host replacement of <util/crc16.h>, same results as the avr-libc versions.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HOST_CRC16_H_
+#define _HOST_CRC16_H_
+
+#include <stdint.h>
+
+/* polynomial 0xA001, reflected */
+static inline uint16_t _crc16_update(uint16_t crc, uint8_t data)
+{
+    uint8_t bit;
+
+    crc ^= data;
+    for (bit = 0; bit < 8U; bit++)
+    {
+        crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0xA001U) : (uint16_t)(crc >> 1);
+    }
+    return crc;
+}
+
+/* polynomial 0x07 */
+static inline uint8_t _crc8_ccitt_update(uint8_t crc, uint8_t data)
+{
+    uint8_t bit;
+
+    crc ^= data;
+    for (bit = 0; bit < 8U; bit++)
+    {
+        crc = (crc & 0x80U) ? (uint8_t)((crc << 1) ^ 0x07U) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+#endif /* _HOST_CRC16_H_ */
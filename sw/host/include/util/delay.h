@@ -0,0 +1,21 @@
+/* *************************************************************************************************
+ * file:        delay.h
+ *
+ *          Host replacement of <util/delay.h>, waiting takes no time.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+#ifndef _HOST_DELAY_H_
+#define _HOST_DELAY_H_
+
+#define _delay_us(us)           ((void)(us))
+#define _delay_ms(ms)           ((void)(ms))
+
+#endif /* _HOST_DELAY_H_ */
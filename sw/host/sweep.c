@@ -0,0 +1,382 @@
+/* *************************************************************************************************
+ * file:        sweep.c
+ *
+ *          Exhaustive host check of the indicator decisions, built once per target by the Makefile.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent overlap of the 5 and 6 cell windows checked, part of "make test"
+ *          19.10.2026  agent windows cut half way to their neighbours, any overlap fails
+ *          19.10.2026  agent a hysteresis band per threshold
+ *
+ * notes:
+ *          the switch and the battery are read with 10 bits, so every input of the decisions
+ *          can be tried. the firmware functions are run for each of the 1024 switch codes and
+ *          for each (switch code, battery code) pair and compared with a reference model:
+ *
+ *          switch  code x selects cell n if it lies inside the open window LIPO_CELL_n +- DIGIT_DIFF
+ *                  and is closer to LIPO_CELL_n than to the code of any other cell count
+ *          level   number of thresholds above x, the thresholds are the pack voltages of
+ *                  indicator_thresholdPercent() on the discharge curve of the chemistry
+ *          falling number of thresholds t with x + band(t) < t while x only goes down
+ *          rising  number of thresholds t with x < t + band(t) while x only goes up, the band
+ *                  is hysteresis_digits(t)
+ *
+ *          the reference is computed for all codes at once, a window or a threshold at a time.
+ *          invariants besides the reference: every window is gap free, holds its nominal code
+ *          and comes after the one of fewer cells, no code of a window is as close to the code
+ *          of another cell count, every level is reached and the level never rises with the
+ *          voltage. the windows and the margins of the nominal codes to their ends are listed
+ *          on stderr.
+ *
+ *          LIPO_CELL_5 and LIPO_CELL_6 are only 12 codes apart, from DIGIT_DIFF 7 on their
+ *          windows are cut at the middle and code 644 gives no cell count. see tolerance.c for
+ *          the spread of the board.
+ *
+ *          the decision tables go to stdout as runs of equal results, "make sweep" compares
+ *          them between the targets. the findings go to stderr, the exit code is the number
+ *          of failed checks, at most 255.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "hal_host.h"
+#include "indicator/indicator.h"
+#include "soc/soc.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* 10 bit codes */
+#define SWEEP_CODES                 (1024U)
+
+#define SWEEP_LEVELS                (LED_UNDER_20_PERCENT + 1U)
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static void sweep_fail(const char *format_pc, ...);
+static void sweep_referenceSwitch(void);
+static void sweep_referenceLevels(uint8 cells_ui8);
+static ledPercentIndicatorType sweep_fresh(lipoCellSwitchType cells_e, uint16 code_ui16);
+static void sweep_checkSwitch(void);
+static void sweep_checkLevels(uint8 cells_ui8);
+static void sweep_checkPairs(void);
+static void sweep_printRuns(const char *name_pc, uint8 cells_ui8, const uint8 *table_pui8);
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static const uint16 sweep_nominal_aui16[MAX_NUM_OF_CELLS] =
+{
+    LIPO_CELL_1, LIPO_CELL_2, LIPO_CELL_3, LIPO_CELL_4, LIPO_CELL_5, LIPO_CELL_6
+};
+
+/* reference model, index 0 of the levels is unused */
+static uint8 sweep_switch_aui8[SWEEP_CODES];
+static uint8 sweep_level_aaui8[MAX_NUM_OF_CELLS + 1U][SWEEP_CODES];
+static uint16 sweep_threshold_aaui16[MAX_NUM_OF_CELLS + 1U][NUM_OF_THRESHOLDS];
+
+/* the firmware */
+static uint8 sweep_firmware_aaui8[MAX_NUM_OF_CELLS + 1U][SWEEP_CODES];
+
+static uint32 sweep_failures_ui32;
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+int main(void)
+{
+    struct timespec start_s;
+    struct timespec end_s;
+    double milliSeconds_f64;
+    uint8 cells_ui8;
+
+    hal_init();
+    soc_init();
+#if (INDICATOR_SETTINGS == STD_ON)
+    settings_init();
+#endif
+
+    clock_gettime(CLOCK_MONOTONIC, &start_s);
+    sweep_referenceSwitch();
+    sweep_checkSwitch();
+    for (cells_ui8 = 1; cells_ui8 <= MAX_NUM_OF_CELLS; cells_ui8++)
+    {
+        sweep_referenceLevels(cells_ui8);
+        sweep_checkLevels(cells_ui8);
+    }
+    sweep_checkPairs();
+    clock_gettime(CLOCK_MONOTONIC, &end_s);
+
+    sweep_printRuns("switch", 0, sweep_switch_aui8);
+    for (cells_ui8 = 1; cells_ui8 <= MAX_NUM_OF_CELLS; cells_ui8++)
+    {
+        sweep_printRuns("level", cells_ui8, sweep_firmware_aaui8[cells_ui8]);
+    }
+
+    milliSeconds_f64 = ((double)(end_s.tv_sec - start_s.tv_sec) * 1e3) + ((double)(end_s.tv_nsec - start_s.tv_nsec) / 1e6);
+    fprintf(stderr, "%s: %lu failed checks, %lu pairs in %.1f ms\n", BENCH_TARGET, (unsigned long)sweep_failures_ui32,
+            (unsigned long)SWEEP_CODES * SWEEP_CODES, milliSeconds_f64);
+
+    return (sweep_failures_ui32 > 255U) ? 255 : (int)sweep_failures_ui32;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* the first 10 findings are printed, all are counted */
+static void sweep_fail(const char *format_pc, ...)
+{
+    va_list args_s;
+
+    if (sweep_failures_ui32 < 10U)
+    {
+        va_start(args_s, format_pc);
+        fprintf(stderr, "%s: ", BENCH_TARGET);
+        vfprintf(stderr, format_pc, args_s);
+        fprintf(stderr, "\n");
+        va_end(args_s);
+    }
+    sweep_failures_ui32++;
+}
+
+/* the open window n +- d, cut where 2x reaches the sum with the code of a neighbour */
+static void sweep_referenceSwitch(void)
+{
+    uint16 code_ui16;
+    uint8 cell_ui8;
+
+    for (code_ui16 = 0; code_ui16 < SWEEP_CODES; code_ui16++)
+    {
+        sweep_switch_aui8[code_ui16] = SWITCH_CELL_NONE;
+    }
+    for (cell_ui8 = 1; cell_ui8 <= MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        uint16 nominal_ui16 = sweep_nominal_aui16[cell_ui8 - 1U];
+        uint16 below_ui16 = (cell_ui8 > 1U) ? sweep_nominal_aui16[cell_ui8 - 2U] : (uint16)(nominal_ui16 - 2 * DIGIT_DIFF);
+        uint16 above_ui16 = (cell_ui8 < MAX_NUM_OF_CELLS) ? sweep_nominal_aui16[cell_ui8] : (uint16)(nominal_ui16 + 2 * DIGIT_DIFF);
+        uint16 low_ui16 = (uint16)(nominal_ui16 - DIGIT_DIFF + 1);
+        uint16 high_ui16 = (uint16)(nominal_ui16 + DIGIT_DIFF - 1);
+        uint16 cutLow_ui16 = (uint16)((below_ui16 + nominal_ui16) / 2U + 1U);
+        uint16 cutHigh_ui16 = (uint16)((nominal_ui16 + above_ui16 - 1U) / 2U);
+
+        low_ui16 = (cutLow_ui16 > low_ui16) ? cutLow_ui16 : low_ui16;
+        high_ui16 = (cutHigh_ui16 < high_ui16) ? cutHigh_ui16 : high_ui16;
+        for (code_ui16 = low_ui16; code_ui16 <= high_ui16; code_ui16++)
+        {
+            sweep_switch_aui8[code_ui16] = cell_ui8;
+        }
+    }
+}
+
+static void sweep_referenceLevels(uint8 cells_ui8)
+{
+    uint8 *level_pui8 = sweep_level_aaui8[cells_ui8];
+    uint16 code_ui16;
+    uint8 level_ui8;
+
+    for (code_ui16 = 0; code_ui16 < SWEEP_CODES; code_ui16++)
+    {
+        level_pui8[code_ui16] = LED_FULL;
+    }
+    for (level_ui8 = 0; level_ui8 < NUM_OF_THRESHOLDS; level_ui8++)
+    {
+        uint16 threshold_ui16 = ubat_millivolt_to_digit((uint32)soc_getCellMilliVolt(indicator_thresholdPercent(level_ui8)) * cells_ui8);
+
+        sweep_threshold_aaui16[cells_ui8][level_ui8] = threshold_ui16;
+        for (code_ui16 = 0; code_ui16 < SWEEP_CODES; code_ui16++)
+        {
+            level_pui8[code_ui16] += (uint8)(code_ui16 < threshold_ui16);
+        }
+    }
+}
+
+/* a change of the cell count makes checkUbatState() forget its level */
+static ledPercentIndicatorType sweep_fresh(lipoCellSwitchType cells_e, uint16 code_ui16)
+{
+    (void)checkUbatState((cells_e == SWITCH_CELL_1) ? SWITCH_CELL_2 : SWITCH_CELL_1, code_ui16);
+    return checkUbatState(cells_e, code_ui16);
+}
+
+static void sweep_checkSwitch(void)
+{
+    uint16 first_aui16[MAX_NUM_OF_CELLS + 1U] = {0};
+    uint16 count_aui16[MAX_NUM_OF_CELLS + 1U] = {0};
+    uint8 last_ui8 = SWITCH_CELL_NONE;
+    uint16 code_ui16;
+    uint8 cell_ui8;
+
+    for (code_ui16 = 0; code_ui16 < SWEEP_CODES; code_ui16++)
+    {
+        uint8 cells_ui8 = (uint8)checkLipoSwitch(code_ui16);
+
+        if (cells_ui8 != sweep_switch_aui8[code_ui16])
+        {
+            sweep_fail("switch: code %u gives %u cells, the reference %u", (unsigned)code_ui16, (unsigned)cells_ui8, (unsigned)(sweep_switch_aui8[code_ui16]));
+        }
+        if ((cells_ui8 != SWITCH_CELL_NONE) && (cells_ui8 <= MAX_NUM_OF_CELLS))
+        {
+            /* no overlap: the code is closer to its own nominal code than to any other */
+            for (cell_ui8 = 1; cell_ui8 <= MAX_NUM_OF_CELLS; cell_ui8++)
+            {
+                if ((cell_ui8 != cells_ui8) &&
+                    (abs((int)code_ui16 - (int)sweep_nominal_aui16[cell_ui8 - 1U]) <= abs((int)code_ui16 - (int)sweep_nominal_aui16[cells_ui8 - 1U])))
+                {
+                    sweep_fail("switch: code %u gives %u cells, but is as close to the code of %u cells", (unsigned)code_ui16,
+                               (unsigned)cells_ui8, (unsigned)cell_ui8);
+                }
+            }
+            if (cells_ui8 < last_ui8)
+            {
+                sweep_fail("switch: code %u gives %u cells after %u cells", (unsigned)code_ui16, (unsigned)cells_ui8, (unsigned)last_ui8);
+            }
+            if (count_aui16[cells_ui8]++ == 0U)
+            {
+                first_aui16[cells_ui8] = code_ui16;
+            }
+            else if ((first_aui16[cells_ui8] + count_aui16[cells_ui8] - 1U) != code_ui16)
+            {
+                sweep_fail("switch: window of %u cells has a gap before code %u", (unsigned)cells_ui8, (unsigned)code_ui16);
+            }
+            last_ui8 = cells_ui8;
+        }
+    }
+
+    for (cell_ui8 = 1; cell_ui8 <= MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        if (checkLipoSwitch(sweep_nominal_aui16[cell_ui8 - 1U]) != cell_ui8)
+        {
+            sweep_fail("switch: nominal code %u does not give %u cells", (unsigned)(sweep_nominal_aui16[cell_ui8 - 1U]), (unsigned)cell_ui8);
+        }
+        else
+        {
+            /* the margins left for the resistors */
+            fprintf(stderr, "%s: switch %u cells: codes %u..%u, nominal %u -%u +%u\n", BENCH_TARGET, (unsigned)cell_ui8,
+                    (unsigned)first_aui16[cell_ui8], (unsigned)(first_aui16[cell_ui8] + count_aui16[cell_ui8] - 1U),
+                    (unsigned)sweep_nominal_aui16[cell_ui8 - 1U], (unsigned)(sweep_nominal_aui16[cell_ui8 - 1U] - first_aui16[cell_ui8]),
+                    (unsigned)(first_aui16[cell_ui8] + count_aui16[cell_ui8] - 1U - sweep_nominal_aui16[cell_ui8 - 1U]));
+        }
+    }
+}
+
+static void sweep_checkLevels(uint8 cells_ui8)
+{
+    const uint8 *reference_pui8 = sweep_level_aaui8[cells_ui8];
+    uint8 *firmware_pui8 = sweep_firmware_aaui8[cells_ui8];
+    const uint16 *threshold_pui16 = sweep_threshold_aaui16[cells_ui8];
+    boolean reached_ab[SWEEP_LEVELS] = {FALSE};
+    uint16 code_ui16;
+    uint8 expected_ui8;
+    uint8 level_ui8;
+    uint8 threshold_ui8;
+
+    for (code_ui16 = 0; code_ui16 < SWEEP_CODES; code_ui16++)
+    {
+        level_ui8 = (uint8)sweep_fresh((lipoCellSwitchType)cells_ui8, code_ui16);
+        firmware_pui8[code_ui16] = level_ui8;
+        if (level_ui8 != reference_pui8[code_ui16])
+        {
+            sweep_fail("level: %u cells, code %u gives %u", (unsigned)cells_ui8, (unsigned)code_ui16, (unsigned)level_ui8);
+        }
+        if ((code_ui16 > 0U) && (level_ui8 > firmware_pui8[code_ui16 - 1U]))
+        {
+            sweep_fail("level: %u cells, code %u shows less than code %u", (unsigned)cells_ui8, (unsigned)code_ui16, (unsigned)(code_ui16 - 1U));
+        }
+        if (level_ui8 < SWEEP_LEVELS)
+        {
+            reached_ab[level_ui8] = TRUE;
+        }
+    }
+    for (level_ui8 = 0; level_ui8 < SWEEP_LEVELS; level_ui8++)
+    {
+        if (reached_ab[level_ui8] == FALSE)
+        {
+            sweep_fail("level: %u cells never show level %u", (unsigned)cells_ui8, (unsigned)level_ui8);
+        }
+    }
+
+    /* falling from the top, a threshold is passed a band below it */
+    (void)sweep_fresh((lipoCellSwitchType)cells_ui8, SWEEP_CODES - 1U);
+    for (code_ui16 = SWEEP_CODES; code_ui16-- > 0U;)
+    {
+        level_ui8 = (uint8)checkUbatState((lipoCellSwitchType)cells_ui8, code_ui16);
+        expected_ui8 = LED_FULL;
+        for (threshold_ui8 = 0; threshold_ui8 < NUM_OF_THRESHOLDS; threshold_ui8++)
+        {
+            expected_ui8 += (uint8)((uint32)(code_ui16 + hysteresis_digits(threshold_pui16[threshold_ui8])) < threshold_pui16[threshold_ui8]);
+        }
+        if (level_ui8 != expected_ui8)
+        {
+            sweep_fail("falling: %u cells, code %u gives %u", (unsigned)cells_ui8, (unsigned)code_ui16, (unsigned)level_ui8);
+        }
+    }
+
+    /* rising from the bottom, a threshold is passed a band above it */
+    (void)sweep_fresh((lipoCellSwitchType)cells_ui8, 0);
+    for (code_ui16 = 0; code_ui16 < SWEEP_CODES; code_ui16++)
+    {
+        level_ui8 = (uint8)checkUbatState((lipoCellSwitchType)cells_ui8, code_ui16);
+        expected_ui8 = LED_FULL;
+        for (threshold_ui8 = 0; threshold_ui8 < NUM_OF_THRESHOLDS; threshold_ui8++)
+        {
+            expected_ui8 += (uint8)(code_ui16 < (uint32)(threshold_pui16[threshold_ui8] + hysteresis_digits(threshold_pui16[threshold_ui8])));
+        }
+        if (level_ui8 != expected_ui8)
+        {
+            sweep_fail("rising: %u cells, code %u gives %u", (unsigned)cells_ui8, (unsigned)code_ui16, (unsigned)level_ui8);
+        }
+    }
+}
+
+/* the chain of the main loop: switch code to cells, cells and battery code to the level */
+static void sweep_checkPairs(void)
+{
+    uint16 switch_ui16;
+    uint16 ubat_ui16;
+
+    for (switch_ui16 = 0; switch_ui16 < SWEEP_CODES; switch_ui16++)
+    {
+        lipoCellSwitchType cells_e = checkLipoSwitch(switch_ui16);
+        const uint8 *reference_pui8 = sweep_level_aaui8[sweep_switch_aui8[switch_ui16]];
+
+        for (ubat_ui16 = 0; ubat_ui16 < SWEEP_CODES; ubat_ui16++)
+        {
+            uint8 level_ui8 = (uint8)sweep_fresh(cells_e, ubat_ui16);
+            uint8 expected_ui8 = (cells_e == SWITCH_CELL_NONE) ? (uint8)LED_INVALID : reference_pui8[ubat_ui16];
+
+            if (level_ui8 != expected_ui8)
+            {
+                sweep_fail("pair: switch %u, battery %u gives %u", (unsigned)switch_ui16, (unsigned)ubat_ui16, (unsigned)level_ui8);
+            }
+        }
+    }
+}
+
+/* <name> <cells> <first code> <last code> <result> */
+static void sweep_printRuns(const char *name_pc, uint8 cells_ui8, const uint8 *table_pui8)
+{
+    uint16 first_ui16 = 0;
+    uint16 code_ui16;
+
+    for (code_ui16 = 1; code_ui16 <= SWEEP_CODES; code_ui16++)
+    {
+        if ((code_ui16 == SWEEP_CODES) || (table_pui8[code_ui16] != table_pui8[first_ui16]))
+        {
+            printf("%s %u %u %u %u\n", name_pc, cells_ui8, first_ui16, code_ui16 - 1U, table_pui8[first_ui16]);
+            first_ui16 = code_ui16;
+        }
+    }
+}
+
+
+/* ************************************ E O F *************************************************** */
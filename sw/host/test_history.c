@@ -0,0 +1,103 @@
+/* *************************************************************************************************
+ * file:        test_history.c
+ *
+ *          Host test of the history, built once per target by the Makefile.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          history_add() runs for TEST_LEVEL2_SLOTS slots of level 2 with a saw tooth of the
+ *          cell voltage and must not write a single eeprom byte on the way, the writes are
+ *          counted by include/avr/eeprom.h. then history_save() has to write, a second save
+ *          nothing, and history_init() has to bring levels 1 and 2 back from the eeprom. the
+ *          exit code is 0 if all checks passed.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <string.h>
+#include <avr/eeprom.h>
+#include "hal_host.h"
+#include "host_test.h"
+#include "history/history.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+#define TEST_LEVEL2_SLOTS           (3U)
+#define TEST_SAMPLES_PER_SLOT       ((uint32)HISTORY_LEVEL0_CYCLES * HISTORY_LEVEL1_SLOTS * HISTORY_LEVEL2_SLOTS)
+
+/* the saw tooth, 3.0V to 4.2V in 10mV steps */
+#define TEST_LOW_MV                 (3000U)
+#define TEST_STEPS                  (121U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static history_DataType test_saved_s;
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+int main(void)
+{
+    const history_DataType *data_ps;
+    const history_SlotType *slot_ps;
+    uint32 sample_ui32;
+    uint32 writes_ui32;
+    uint8 level_ui8;
+
+    history_init();
+    writes_ui32 = host_eepromWrites;
+
+    for (sample_ui32 = 0; sample_ui32 < (TEST_LEVEL2_SLOTS * TEST_SAMPLES_PER_SLOT); sample_ui32++)
+    {
+        history_add((uint16)(TEST_LOW_MV + HISTORY_STEP_MV * (sample_ui32 % TEST_STEPS)));
+    }
+    data_ps = history_get();
+    host_expect(data_ps->levels_as[2].count_ui8 == TEST_LEVEL2_SLOTS, "%u slots in level 2, not %u", data_ps->levels_as[2].count_ui8,
+                TEST_LEVEL2_SLOTS);
+    host_expect(host_eepromWrites == writes_ui32, "history_add() wrote %lu eeprom bytes",
+                (unsigned long)(host_eepromWrites - writes_ui32));
+
+    /* a level 2 slot spans the whole saw tooth */
+    slot_ps = &data_ps->levels_as[2].slots_as[0];
+    host_expect(history_decode(slot_ps->min_ui8) == TEST_LOW_MV, "level 2 min %u mV", history_decode(slot_ps->min_ui8));
+    host_expect(history_decode(slot_ps->max_ui8) == (TEST_LOW_MV + HISTORY_STEP_MV * (TEST_STEPS - 1U)), "level 2 max %u mV",
+                history_decode(slot_ps->max_ui8));
+    host_expect((slot_ps->avg_ui8 > slot_ps->min_ui8) && (slot_ps->avg_ui8 < slot_ps->max_ui8), "level 2 avg %u mV",
+                history_decode(slot_ps->avg_ui8));
+
+    /* only the changed bytes are written */
+    history_save();
+    host_expect(host_eepromWrites > writes_ui32, "history_save() wrote nothing");
+    writes_ui32 = host_eepromWrites;
+    history_save();
+    host_expect(host_eepromWrites == writes_ui32, "a second history_save() wrote %lu bytes",
+                (unsigned long)(host_eepromWrites - writes_ui32));
+
+    /* after a reset levels 1 and 2 come back, level 0 is gone */
+    memcpy(&test_saved_s, data_ps, sizeof(test_saved_s));
+    history_init();
+    host_expect(data_ps->levels_as[0].count_ui8 == 0U, "level 0 survived the reset");
+    for (level_ui8 = 1; level_ui8 < HISTORY_NUM_OF_LEVELS; level_ui8++)
+    {
+        host_expect(memcmp(&data_ps->levels_as[level_ui8], &test_saved_s.levels_as[level_ui8], sizeof(history_LevelType)) == 0,
+                    "level %u not restored", level_ui8);
+    }
+
+    return host_testResult("history");
+}
+
+
+/* ************************************ E O F *************************************************** */
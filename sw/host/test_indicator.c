@@ -0,0 +1,400 @@
+/* *************************************************************************************************
+ * file:        test_indicator.c
+ *
+ *          Host test of the indicator decisions, built once per target by the Makefile.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the decisions keep their state in static variables, so the cases run in a fixed
+ *          order and each one starts from the state the one before left behind. the leds are
+ *          read back from the simulated port of hal_host.c. the exit code is 0 if all checks
+ *          passed.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include "hal_host.h"
+#include "host_test.h"
+#include "indicator/indicator.h"
+#include "soc/soc.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* 10 bit codes */
+#define TEST_CODES                  (1024U)
+
+/* the bar has 5 segments */
+#define TEST_LED_MASK               (0x1FU)
+
+/* noise of the battery reading, +- digits */
+#define TEST_NOISE_DIGITS           (3U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static void test_switchDecode(void);
+static void test_switchDebounce(void);
+static void test_cellDetect(void);
+static void test_cellLatch(void);
+static uint16 test_threshold(uint8 cells_ui8, uint8 level_ui8);
+static ledPercentIndicatorType test_fresh(lipoCellSwitchType cells_e, uint16 code_ui16);
+static void test_thresholds(void);
+static void test_hysteresis(void);
+static void test_oneCellNoise(void);
+static void test_leds(void);
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static const uint16 test_nominal_aui16[MAX_NUM_OF_CELLS] =
+{
+    LIPO_CELL_1, LIPO_CELL_2, LIPO_CELL_3, LIPO_CELL_4, LIPO_CELL_5, LIPO_CELL_6
+};
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+int main(void)
+{
+    hal_init();
+    soc_init();
+#if (INDICATOR_SETTINGS == STD_ON)
+    settings_init();
+#endif
+
+    test_switchDecode();
+    test_switchDebounce();
+    test_cellDetect();
+    test_cellLatch();
+    test_thresholds();
+    test_hysteresis();
+    test_oneCellNoise();
+    test_leds();
+
+    return host_testResult("indicator");
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* every nominal code decodes to its cell count, the window is open at +-DIGIT_DIFF and ends
+ * half way to the code of a neighbour, the code in the middle belongs to neither
+ */
+static void test_switchDecode(void)
+{
+    uint8 cell_ui8;
+
+    host_expect(checkLipoSwitch(0) == SWITCH_CELL_NONE, "switch: code 0 decodes to %d", checkLipoSwitch(0));
+    host_expect(checkLipoSwitch(TEST_CODES - 1U) == SWITCH_CELL_NONE, "switch: code 1023 decodes to %d",
+                checkLipoSwitch(TEST_CODES - 1U));
+
+    for (cell_ui8 = 1; cell_ui8 <= MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        uint16 nominal_ui16 = test_nominal_aui16[cell_ui8 - 1U];
+        uint16 below_ui16 = (cell_ui8 > 1U) ? (uint16)(nominal_ui16 - test_nominal_aui16[cell_ui8 - 2U]) : 0xFFFFU;
+        uint16 above_ui16 = (cell_ui8 < MAX_NUM_OF_CELLS) ? (uint16)(test_nominal_aui16[cell_ui8] - nominal_ui16) : 0xFFFFU;
+        lipoCellSwitchType low_e = checkLipoSwitch((uint16)(nominal_ui16 - DIGIT_DIFF + 1));
+        lipoCellSwitchType high_e = checkLipoSwitch((uint16)(nominal_ui16 + DIGIT_DIFF - 1));
+
+        host_expect(checkLipoSwitch(nominal_ui16) == cell_ui8, "switch: nominal %u decodes to %d, not %u",
+                    nominal_ui16, checkLipoSwitch(nominal_ui16), cell_ui8);
+        /* the edges of the window belong to it unless they are half way to a neighbour */
+        host_expect((low_e == cell_ui8) == ((2U * (DIGIT_DIFF - 1U)) < below_ui16), "switch: %u - %d + 1 decodes to %d",
+                    nominal_ui16, DIGIT_DIFF, low_e);
+        host_expect((high_e == cell_ui8) == ((2U * (DIGIT_DIFF - 1U)) < above_ui16), "switch: %u + %d - 1 decodes to %d",
+                    nominal_ui16, DIGIT_DIFF, high_e);
+        host_expect(checkLipoSwitch((uint16)(nominal_ui16 - DIGIT_DIFF)) != cell_ui8, "switch: %u - %d still decodes to %u",
+                    nominal_ui16, DIGIT_DIFF, cell_ui8);
+        host_expect(checkLipoSwitch((uint16)(nominal_ui16 + DIGIT_DIFF)) != cell_ui8, "switch: %u + %d still decodes to %u",
+                    nominal_ui16, DIGIT_DIFF, cell_ui8);
+    }
+
+    /* 5 and 6 cells are 12 codes apart */
+    host_expect(checkLipoSwitch((LIPO_CELL_5 + LIPO_CELL_6) / 2) == SWITCH_CELL_NONE, "switch: middle of 5 and 6 cells decodes to %d",
+                checkLipoSwitch((LIPO_CELL_5 + LIPO_CELL_6) / 2));
+    host_expect(checkLipoSwitch((LIPO_CELL_5 + LIPO_CELL_6) / 2 - 1) == SWITCH_CELL_5, "switch: below the middle of 5 and 6 cells");
+    host_expect(checkLipoSwitch((LIPO_CELL_5 + LIPO_CELL_6) / 2 + 1) == SWITCH_CELL_6, "switch: above the middle of 5 and 6 cells");
+}
+
+/* a new position needs SWITCH_DEBOUNCE_SAMPLES equal decodes in a row */
+static void test_switchDebounce(void)
+{
+    uint8 sample_ui8;
+
+    for (sample_ui8 = 1; sample_ui8 < SWITCH_DEBOUNCE_SAMPLES; sample_ui8++)
+    {
+        host_expect(debounceLipoSwitch(SWITCH_CELL_3) == SWITCH_CELL_NONE, "debounce: cell 3 taken after %u samples", sample_ui8);
+    }
+    host_expect(debounceLipoSwitch(SWITCH_CELL_3) == SWITCH_CELL_3, "debounce: cell 3 not taken after %u samples",
+                SWITCH_DEBOUNCE_SAMPLES);
+
+    /* a single glitch is dropped, the confirmed position resets the count */
+    host_expect(debounceLipoSwitch(SWITCH_CELL_1) == SWITCH_CELL_3, "debounce: one glitch taken");
+    host_expect(debounceLipoSwitch(SWITCH_CELL_3) == SWITCH_CELL_3, "debounce: confirmed position lost");
+    for (sample_ui8 = 1; sample_ui8 < SWITCH_DEBOUNCE_SAMPLES; sample_ui8++)
+    {
+        host_expect(debounceLipoSwitch(SWITCH_CELL_1) == SWITCH_CELL_3, "debounce: cell 1 taken after %u samples", sample_ui8);
+    }
+    host_expect(debounceLipoSwitch(SWITCH_CELL_1) == SWITCH_CELL_1, "debounce: cell 1 not taken after %u samples",
+                SWITCH_DEBOUNCE_SAMPLES);
+}
+
+/* every chemistry detects 1 to 6 cells from the floor up to full + margin, no pack voltage
+ * is in two windows and below the floor nothing is detected
+ */
+static void test_cellDetect(void)
+{
+    uint8 chemistry_ui8;
+
+    for (chemistry_ui8 = 0; chemistry_ui8 < SOC_CHEMISTRY_COUNT; chemistry_ui8++)
+    {
+        const soc_ProfileType *profile_ps;
+        uint32 milliVolt_ui32;
+        uint8 cells_ui8;
+
+        soc_setChemistry((soc_ChemistryType)chemistry_ui8);
+        profile_ps = soc_getProfile();
+        for (cells_ui8 = 1; cells_ui8 <= MAX_NUM_OF_CELLS; cells_ui8++)
+        {
+            uint16 floor_ui16 = (uint16)(cells_ui8 * profile_ps->detectMilliVolt_ui16);
+            uint16 nominal_ui16 = (uint16)(cells_ui8 * profile_ps->nominalMilliVolt_ui16);
+            uint16 top_ui16 = (uint16)(cells_ui8 * (profile_ps->fullMilliVolt_ui16 + CELL_DETECTION_MARGIN_MV));
+
+            host_expect(detectLipoCells(floor_ui16) == cells_ui8, "detect: chemistry %u, %u mV at the floor gives %d, not %u cells",
+                        chemistry_ui8, floor_ui16, detectLipoCells(floor_ui16), cells_ui8);
+            host_expect(detectLipoCells(nominal_ui16) == cells_ui8, "detect: chemistry %u, %u mV nominal gives %d, not %u cells",
+                        chemistry_ui8, nominal_ui16, detectLipoCells(nominal_ui16), cells_ui8);
+            host_expect(detectLipoCells(top_ui16) == cells_ui8, "detect: chemistry %u, %u mV full gives %d, not %u cells",
+                        chemistry_ui8, top_ui16, detectLipoCells(top_ui16), cells_ui8);
+            host_expect(detectLipoCells((uint16)(floor_ui16 - 1U)) != cells_ui8, "detect: chemistry %u, %u mV below the floor gives %u cells",
+                        chemistry_ui8, floor_ui16 - 1U, cells_ui8);
+        }
+        host_expect(detectLipoCells((uint16)(profile_ps->detectMilliVolt_ui16 - 1U)) == SWITCH_CELL_NONE,
+                    "detect: chemistry %u, below one cell gives %d cells", chemistry_ui8,
+                    detectLipoCells((uint16)(profile_ps->detectMilliVolt_ui16 - 1U)));
+
+        /* the windows are apart, every voltage is in at most one of them */
+        for (milliVolt_ui32 = 0; milliVolt_ui32 <= (MAX_NUM_OF_CELLS * (profile_ps->fullMilliVolt_ui16 + CELL_DETECTION_MARGIN_MV)); milliVolt_ui32++)
+        {
+            uint8 windows_ui8 = 0;
+
+            for (cells_ui8 = 1; cells_ui8 <= MAX_NUM_OF_CELLS; cells_ui8++)
+            {
+                if ((milliVolt_ui32 >= ((uint32)cells_ui8 * profile_ps->detectMilliVolt_ui16)) &&
+                    (milliVolt_ui32 <= ((uint32)cells_ui8 * (profile_ps->fullMilliVolt_ui16 + CELL_DETECTION_MARGIN_MV))))
+                {
+                    windows_ui8++;
+                }
+            }
+            if (windows_ui8 > 1U)
+            {
+                host_expect(FALSE, "detect: chemistry %u, %lu mV in %u windows", chemistry_ui8, (unsigned long)milliVolt_ui32, windows_ui8);
+                break;
+            }
+        }
+    }
+    soc_setChemistry(SOC_CHEMISTRY_LIPO);
+}
+
+/* the cell count from the pack voltage latches after CELL_DETECTION_SAMPLES equal detections */
+static void test_cellLatch(void)
+{
+    uint8 sample_ui8;
+
+    /* nothing detected and a different count restart the count */
+    host_expect(latchLipoCells(SWITCH_CELL_NONE) == SWITCH_CELL_NONE, "latch: latched without a detection");
+    for (sample_ui8 = 1; sample_ui8 < CELL_DETECTION_SAMPLES; sample_ui8++)
+    {
+        host_expect(latchLipoCells(SWITCH_CELL_3) == SWITCH_CELL_NONE, "latch: latched after %u samples", sample_ui8);
+    }
+    host_expect(latchLipoCells(SWITCH_CELL_2) == SWITCH_CELL_NONE, "latch: latched on a different count");
+    host_expect(latchLipoCells(SWITCH_CELL_NONE) == SWITCH_CELL_NONE, "latch: latched on nothing detected");
+    for (sample_ui8 = 1; sample_ui8 < CELL_DETECTION_SAMPLES; sample_ui8++)
+    {
+        host_expect(latchLipoCells(SWITCH_CELL_3) == SWITCH_CELL_NONE, "latch: count not restarted, latched after %u samples",
+                    sample_ui8);
+    }
+    host_expect(latchLipoCells(SWITCH_CELL_3) == SWITCH_CELL_3, "latch: not latched after %u samples", CELL_DETECTION_SAMPLES);
+
+    /* held against other detections */
+    host_expect(latchLipoCells(SWITCH_CELL_4) == SWITCH_CELL_3, "latch: latch lost on another count");
+    host_expect(latchLipoCells(SWITCH_CELL_NONE) == SWITCH_CELL_3, "latch: latch lost on nothing detected");
+
+    /* a new chemistry has other windows, the count is detected again */
+    soc_setChemistry(SOC_CHEMISTRY_LIFEPO4);
+    host_expect(latchLipoCells(SWITCH_CELL_NONE) == SWITCH_CELL_NONE, "latch: held over a change of the chemistry");
+    for (sample_ui8 = 1; sample_ui8 < CELL_DETECTION_SAMPLES; sample_ui8++)
+    {
+        host_expect(latchLipoCells(SWITCH_CELL_4) == SWITCH_CELL_NONE, "latch: latched after %u samples of the new chemistry",
+                    sample_ui8);
+    }
+    host_expect(latchLipoCells(SWITCH_CELL_4) == SWITCH_CELL_4, "latch: not latched again after %u samples", CELL_DETECTION_SAMPLES);
+    soc_setChemistry(SOC_CHEMISTRY_LIPO);
+    host_expect(latchLipoCells(SWITCH_CELL_3) == SWITCH_CELL_NONE, "latch: held over the change back");
+    for (sample_ui8 = 1; sample_ui8 < CELL_DETECTION_SAMPLES; sample_ui8++)
+    {
+        (void)latchLipoCells(SWITCH_CELL_3);
+    }
+    host_expect(latchLipoCells(SWITCH_CELL_3) == SWITCH_CELL_3, "latch: not latched after the change back");
+}
+
+/* the threshold of a level as setCellThresholds() computes it */
+static uint16 test_threshold(uint8 cells_ui8, uint8 level_ui8)
+{
+    return ubat_millivolt_to_digit((uint32)soc_getCellMilliVolt(indicator_thresholdPercent(level_ui8)) * cells_ui8);
+}
+
+/* a change of the cell count makes checkUbatState() forget its level */
+static ledPercentIndicatorType test_fresh(lipoCellSwitchType cells_e, uint16 code_ui16)
+{
+    (void)checkUbatState((cells_e == SWITCH_CELL_1) ? SWITCH_CELL_2 : SWITCH_CELL_1, code_ui16);
+    return checkUbatState(cells_e, code_ui16);
+}
+
+/* decided from scratch a level starts at its threshold, one digit less is the next level */
+static void test_thresholds(void)
+{
+    uint8 cells_ui8;
+    uint8 level_ui8;
+
+    host_expect(checkUbatState(SWITCH_CELL_NONE, 500U) == LED_INVALID, "level: no cell count is not invalid");
+    host_expect(checkUbatState((lipoCellSwitchType)(MAX_NUM_OF_CELLS + 1U), 500U) == LED_INVALID,
+                "level: %u cells are not invalid", MAX_NUM_OF_CELLS + 1U);
+
+    for (cells_ui8 = 1; cells_ui8 <= MAX_NUM_OF_CELLS; cells_ui8++)
+    {
+        host_expect(test_fresh((lipoCellSwitchType)cells_ui8, TEST_CODES - 1U) == LED_FULL, "level: %u cells, 1023 not full", cells_ui8);
+        host_expect(test_fresh((lipoCellSwitchType)cells_ui8, 0) == LED_UNDER_20_PERCENT, "level: %u cells, 0 not under 20%%",
+                    cells_ui8);
+
+        for (level_ui8 = 0; level_ui8 < NUM_OF_THRESHOLDS; level_ui8++)
+        {
+            uint16 threshold_ui16 = test_threshold(cells_ui8, level_ui8);
+            ledPercentIndicatorType at_e = test_fresh((lipoCellSwitchType)cells_ui8, threshold_ui16);
+            ledPercentIndicatorType below_e = test_fresh((lipoCellSwitchType)cells_ui8, (uint16)(threshold_ui16 - 1U));
+
+            host_expect(at_e <= level_ui8, "level: %u cells, threshold %u at %u gives %d", cells_ui8, level_ui8,
+                        threshold_ui16, at_e);
+            host_expect(below_e >= (level_ui8 + 1U), "level: %u cells, threshold %u below %u gives %d", cells_ui8, level_ui8,
+                        threshold_ui16, below_e);
+            if ((level_ui8 + 1U) < NUM_OF_THRESHOLDS)
+            {
+                host_expect(test_threshold(cells_ui8, level_ui8 + 1U) <= threshold_ui16, "level: %u cells, threshold %u rises",
+                            cells_ui8, level_ui8 + 1U);
+            }
+        }
+    }
+}
+
+/* once decided a level is only left outside the band around its thresholds */
+static void test_hysteresis(void)
+{
+    uint8 cells_ui8;
+
+    for (cells_ui8 = 1; cells_ui8 <= MAX_NUM_OF_CELLS; cells_ui8++)
+    {
+        lipoCellSwitchType cells_e = (lipoCellSwitchType)cells_ui8;
+        uint16 threshold_ui16 = test_threshold(cells_ui8, 0);
+        uint16 hysteresis_ui16 = hysteresis_digits(threshold_ui16);
+        uint16 code_ui16;
+
+        host_expect(test_fresh(cells_e, threshold_ui16) == LED_FULL, "hysteresis: %u cells, not full at the threshold", cells_ui8);
+
+        /* falling, full is kept down to the threshold minus the band */
+        for (code_ui16 = threshold_ui16; code_ui16 >= (uint16)(threshold_ui16 - hysteresis_ui16); code_ui16--)
+        {
+            host_expect(checkUbatState(cells_e, code_ui16) == LED_FULL, "hysteresis: %u cells, full left at %u", cells_ui8, code_ui16);
+        }
+        host_expect(checkUbatState(cells_e, code_ui16) == LED_UNDER_80_PERCENT, "hysteresis: %u cells, full kept at %u",
+                    cells_ui8, code_ui16);
+
+        /* rising, under 80% is kept up to the threshold plus the band */
+        for (code_ui16 = (uint16)(threshold_ui16 - hysteresis_ui16); code_ui16 < (uint16)(threshold_ui16 + hysteresis_ui16); code_ui16++)
+        {
+            host_expect(checkUbatState(cells_e, code_ui16) == LED_UNDER_80_PERCENT, "hysteresis: %u cells, under 80%% left at %u",
+                        cells_ui8, code_ui16);
+        }
+        host_expect(checkUbatState(cells_e, code_ui16) == LED_FULL, "hysteresis: %u cells, not full again at %u", cells_ui8,
+                    code_ui16);
+    }
+}
+
+/* a 1 cell pack sitting on a threshold, a digit is about 42mV there. noise of up to
+ * TEST_NOISE_DIGITS around it must not move the level once it is decided.
+ */
+static void test_oneCellNoise(void)
+{
+    uint8 level_ui8;
+    uint8 pass_ui8;
+
+    for (level_ui8 = 0; level_ui8 < NUM_OF_THRESHOLDS; level_ui8++)
+    {
+        uint16 threshold_ui16 = test_threshold(1U, level_ui8);
+        ledPercentIndicatorType decided_e = test_fresh(SWITCH_CELL_1, threshold_ui16);
+        uint16 code_ui16;
+
+        for (pass_ui8 = 0; pass_ui8 < 3U; pass_ui8++)
+        {
+            for (code_ui16 = (uint16)(threshold_ui16 - TEST_NOISE_DIGITS); code_ui16 <= (uint16)(threshold_ui16 + TEST_NOISE_DIGITS);
+                 code_ui16++)
+            {
+                host_expect(checkUbatState(SWITCH_CELL_1, code_ui16) == decided_e, "noise: 1 cell, threshold %u at %u left level %d",
+                            level_ui8, code_ui16, decided_e);
+                host_expect(checkUbatState(SWITCH_CELL_1, (uint16)(2U * threshold_ui16 - code_ui16)) == decided_e,
+                            "noise: 1 cell, threshold %u at %u left level %d", level_ui8, 2U * threshold_ui16 - code_ui16, decided_e);
+            }
+        }
+    }
+}
+
+/* the level on the led port, in the display mode of the target */
+static void test_leds(void)
+{
+    uint8 level_ui8;
+    uint8 expected_ui8;
+
+    for (level_ui8 = LED_FULL; level_ui8 <= LED_UNDER_20_PERCENT; level_ui8++)
+    {
+        switch (indicator_displayMode())
+        {
+            case DISPLAY_MODE_DOT:
+                expected_ui8 = (uint8)(1U << level_ui8);
+                break;
+            case DISPLAY_MODE_BAR:
+                expected_ui8 = (uint8)((TEST_LED_MASK << level_ui8) & TEST_LED_MASK);
+                break;
+            default:
+                /* the strobe is dark between the flashes */
+                expected_ui8 = hal_hostRegisters_s.leds_ui8;
+                break;
+        }
+        showLedStatus((ledPercentIndicatorType)level_ui8);
+        host_expect(hal_hostRegisters_s.leds_ui8 == expected_ui8, "leds: level %u shows 0x%02x, not 0x%02x", level_ui8,
+                    hal_hostRegisters_s.leds_ui8, expected_ui8);
+    }
+
+    showLedStatus(LED_OFF);
+    host_expect(hal_hostRegisters_s.leds_ui8 == 0U, "leds: off shows 0x%02x", hal_hostRegisters_s.leds_ui8);
+
+    showLedStatus(LED_INVALID);
+#if (INDICATOR_INVALID_BLINK == STD_ON)
+    expected_ui8 = hal_hostRegisters_s.leds_ui8;
+    showLedStatus(LED_INVALID);
+    host_expect((expected_ui8 | hal_hostRegisters_s.leds_ui8) == 0x01U, "leds: invalid does not blink the top segment");
+    host_expect(expected_ui8 != hal_hostRegisters_s.leds_ui8, "leds: invalid does not blink");
+#else
+    host_expect(hal_hostRegisters_s.leds_ui8 == 0x15U, "leds: invalid shows 0x%02x", hal_hostRegisters_s.leds_ui8);
+#endif
+}
+
+
+/* ************************************ E O F *************************************************** */
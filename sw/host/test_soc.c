@@ -0,0 +1,178 @@
+/* *************************************************************************************************
+ * file:        test_soc.c
+ *
+ *          Host test of the state of charge curves, built once per target by the Makefile.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          soc_getPercent() and soc_getCellMilliVolt() are checked on the curve of every
+ *          chemistry: the ends and beyond, every point of the curve, monotonicity over every
+ *          millivolt and every percent and the round trip in both directions. both directions
+ *          truncate, so a round trip may lose one step but never gains one. the exit code is 0
+ *          if all checks passed.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include "hal_host.h"
+#include "host_test.h"
+#include "soc/soc.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* millivolts checked below the first and above the last point */
+#define TEST_BEYOND_MILLIVOLT       (500U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static void test_ends(uint8 chemistry_ui8);
+static void test_points(uint8 chemistry_ui8);
+static void test_monotonic(uint8 chemistry_ui8);
+static void test_roundTrip(uint8 chemistry_ui8);
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+int main(void)
+{
+    uint8 chemistry_ui8;
+
+    hal_init();
+    soc_init();
+
+    for (chemistry_ui8 = 0; chemistry_ui8 < SOC_CHEMISTRY_COUNT; chemistry_ui8++)
+    {
+        soc_setChemistry((soc_ChemistryType)chemistry_ui8);
+        host_expect(soc_getChemistry() == chemistry_ui8, "chemistry %u not selected", chemistry_ui8);
+
+        test_ends(chemistry_ui8);
+        test_points(chemistry_ui8);
+        test_monotonic(chemistry_ui8);
+        test_roundTrip(chemistry_ui8);
+    }
+    soc_setChemistry(SOC_CHEMISTRY_LIPO);
+
+    return host_testResult("soc");
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* the curve spans 0% to 100% and is clamped outside */
+static void test_ends(uint8 chemistry_ui8)
+{
+    const soc_ProfileType *profile_ps = soc_getProfile();
+    const soc_CurvePointType *first_ps = &profile_ps->points_ps[0];
+    const soc_CurvePointType *last_ps = &profile_ps->points_ps[profile_ps->numberOfPoints_ui8 - 1U];
+
+    host_expect(profile_ps->numberOfPoints_ui8 >= 2U, "chemistry %u: %u points", chemistry_ui8, profile_ps->numberOfPoints_ui8);
+    host_expect(first_ps->percent_ui8 == SOC_PERCENT_EMPTY, "chemistry %u: curve starts at %u%%", chemistry_ui8,
+                first_ps->percent_ui8);
+    host_expect(last_ps->percent_ui8 == SOC_PERCENT_FULL, "chemistry %u: curve ends at %u%%", chemistry_ui8, last_ps->percent_ui8);
+    host_expect(first_ps->cellMilliVolt_ui16 == profile_ps->emptyMilliVolt_ui16, "chemistry %u: empty %u mV, curve starts at %u mV",
+                chemistry_ui8, profile_ps->emptyMilliVolt_ui16, first_ps->cellMilliVolt_ui16);
+    host_expect(last_ps->cellMilliVolt_ui16 <= profile_ps->fullMilliVolt_ui16, "chemistry %u: full %u mV, curve ends at %u mV",
+                chemistry_ui8, profile_ps->fullMilliVolt_ui16, last_ps->cellMilliVolt_ui16);
+
+    host_expect(soc_getPercent(0) == SOC_PERCENT_EMPTY, "chemistry %u: 0 mV gives %u%%", chemistry_ui8, soc_getPercent(0));
+    host_expect(soc_getPercent(0xFFFFU) == SOC_PERCENT_FULL, "chemistry %u: 65535 mV gives %u%%", chemistry_ui8,
+                soc_getPercent(0xFFFFU));
+    host_expect(soc_getCellMilliVolt(SOC_PERCENT_EMPTY) == first_ps->cellMilliVolt_ui16, "chemistry %u: 0%% gives %u mV",
+                chemistry_ui8, soc_getCellMilliVolt(SOC_PERCENT_EMPTY));
+    host_expect(soc_getCellMilliVolt(SOC_PERCENT_FULL) == last_ps->cellMilliVolt_ui16, "chemistry %u: 100%% gives %u mV",
+                chemistry_ui8, soc_getCellMilliVolt(SOC_PERCENT_FULL));
+    host_expect(soc_getCellMilliVolt(0xFFU) == last_ps->cellMilliVolt_ui16, "chemistry %u: 255%% gives %u mV", chemistry_ui8,
+                soc_getCellMilliVolt(0xFFU));
+}
+
+/* every point of the curve is hit exactly from both sides, the points rise strictly */
+static void test_points(uint8 chemistry_ui8)
+{
+    const soc_ProfileType *profile_ps = soc_getProfile();
+    uint8 point_ui8;
+
+    for (point_ui8 = 0; point_ui8 < profile_ps->numberOfPoints_ui8; point_ui8++)
+    {
+        const soc_CurvePointType *point_ps = &profile_ps->points_ps[point_ui8];
+
+        host_expect(soc_getPercent(point_ps->cellMilliVolt_ui16) == point_ps->percent_ui8, "chemistry %u: %u mV gives %u%%, not %u%%",
+                    chemistry_ui8, point_ps->cellMilliVolt_ui16, soc_getPercent(point_ps->cellMilliVolt_ui16), point_ps->percent_ui8);
+        host_expect(soc_getCellMilliVolt(point_ps->percent_ui8) == point_ps->cellMilliVolt_ui16,
+                    "chemistry %u: %u%% gives %u mV, not %u mV", chemistry_ui8, point_ps->percent_ui8,
+                    soc_getCellMilliVolt(point_ps->percent_ui8), point_ps->cellMilliVolt_ui16);
+        if (point_ui8 > 0U)
+        {
+            host_expect((point_ps->cellMilliVolt_ui16 > point_ps[-1].cellMilliVolt_ui16) && (point_ps->percent_ui8 > point_ps[-1].percent_ui8),
+                        "chemistry %u: point %u does not rise", chemistry_ui8, point_ui8);
+        }
+    }
+}
+
+/* a higher voltage never gives less charge and more charge never a lower voltage */
+static void test_monotonic(uint8 chemistry_ui8)
+{
+    const soc_ProfileType *profile_ps = soc_getProfile();
+    uint16 first_ui16 = (uint16)(profile_ps->points_ps[0].cellMilliVolt_ui16 - TEST_BEYOND_MILLIVOLT);
+    uint16 last_ui16 = (uint16)(profile_ps->points_ps[profile_ps->numberOfPoints_ui8 - 1U].cellMilliVolt_ui16 + TEST_BEYOND_MILLIVOLT);
+    uint16 milliVolt_ui16;
+    uint16 percent_ui16;
+
+    for (milliVolt_ui16 = (uint16)(first_ui16 + 1U); milliVolt_ui16 <= last_ui16; milliVolt_ui16++)
+    {
+        host_expect(soc_getPercent(milliVolt_ui16) >= soc_getPercent((uint16)(milliVolt_ui16 - 1U)),
+                    "chemistry %u: %u mV gives less than %u mV", chemistry_ui8, milliVolt_ui16, milliVolt_ui16 - 1U);
+    }
+    for (percent_ui16 = 1; percent_ui16 <= SOC_PERCENT_FULL; percent_ui16++)
+    {
+        host_expect(soc_getCellMilliVolt((uint8)percent_ui16) >= soc_getCellMilliVolt((uint8)(percent_ui16 - 1U)),
+                    "chemistry %u: %u%% gives less than %u%%", chemistry_ui8, percent_ui16, percent_ui16 - 1U);
+    }
+}
+
+/* percent to millivolt and back loses at most one percent, millivolt to percent and back
+ * stays between the voltages of that percent and the next one
+ */
+static void test_roundTrip(uint8 chemistry_ui8)
+{
+    const soc_ProfileType *profile_ps = soc_getProfile();
+    uint16 first_ui16 = profile_ps->points_ps[0].cellMilliVolt_ui16;
+    uint16 last_ui16 = profile_ps->points_ps[profile_ps->numberOfPoints_ui8 - 1U].cellMilliVolt_ui16;
+    uint16 milliVolt_ui16;
+    uint16 percent_ui16;
+
+    for (percent_ui16 = 0; percent_ui16 <= SOC_PERCENT_FULL; percent_ui16++)
+    {
+        uint8 back_ui8 = soc_getPercent(soc_getCellMilliVolt((uint8)percent_ui16));
+
+        host_expect((back_ui8 <= percent_ui16) && ((back_ui8 + 1U) >= percent_ui16), "chemistry %u: %u%% comes back as %u%%",
+                    chemistry_ui8, percent_ui16, back_ui8);
+    }
+    for (milliVolt_ui16 = first_ui16; milliVolt_ui16 <= last_ui16; milliVolt_ui16++)
+    {
+        uint8 percent_ui8 = soc_getPercent(milliVolt_ui16);
+
+        host_expect(soc_getCellMilliVolt(percent_ui8) <= milliVolt_ui16, "chemistry %u: %u mV gives %u%% at %u mV", chemistry_ui8,
+                    milliVolt_ui16, percent_ui8, soc_getCellMilliVolt(percent_ui8));
+        if (percent_ui8 < SOC_PERCENT_FULL)
+        {
+            host_expect(soc_getCellMilliVolt((uint8)(percent_ui8 + 1U)) >= milliVolt_ui16, "chemistry %u: %u mV gives %u%%, %u%% at %u mV",
+                        chemistry_ui8, milliVolt_ui16, percent_ui8, percent_ui8 + 1U, soc_getCellMilliVolt((uint8)(percent_ui8 + 1U)));
+        }
+    }
+}
+
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,105 @@
+/* *************************************************************************************************
+ * file:        test_stats.c
+ *
+ *          Host test of the statistics, built once per target by the Makefile.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          a save is seen at the sequence of the record. stats_init() saves once for the
+ *          power on, the first sample of the pack must not save again. a dip of one update
+ *          must not reach the minimum, a pack that stays STATS_SAVE_STEP_MV lower has to
+ *          save. the exit code is 0 if all checks passed.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <avr/eeprom.h>
+#include "hal_host.h"
+#include "host_test.h"
+#include "stats/stats.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* a 4 cell pack at rest and a dip under load */
+#define TEST_PACK_MV                (15200U)
+#define TEST_DIP_MV                 (1000U)
+
+/* one main loop cycle, far from a runtime save */
+#define TEST_CYCLE_MS               (100U)
+
+/* updates until the average has settled */
+#define TEST_SETTLE_UPDATES         (16U << STATS_FILTER_SHIFT)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static void test_updates(uint16 packMilliVolt_ui16, uint16 count_ui16);
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+int main(void)
+{
+    const stats_RecordType *record_ps = stats_get();
+    uint16 sequence_ui16;
+
+    stats_init();
+    sequence_ui16 = record_ps->sequence_ui16;
+    host_expect(record_ps->powerOnCount_ui16 == 1U, "power on count %u", record_ps->powerOnCount_ui16);
+    host_expect(record_ps->sessionMinMilliVolt_ui16 == STATS_NO_VOLTAGE, "session minimum %u mV before a sample",
+                record_ps->sessionMinMilliVolt_ui16);
+
+    /* the first sample is the minimum, the power on was saved already */
+    test_updates(TEST_PACK_MV, 1U);
+    host_expect(record_ps->sessionMinMilliVolt_ui16 == TEST_PACK_MV, "session minimum %u mV after the first sample",
+                record_ps->sessionMinMilliVolt_ui16);
+    host_expect(record_ps->sequence_ui16 == sequence_ui16, "the first sample saved %u times",
+                (uint16)(record_ps->sequence_ui16 - sequence_ui16));
+
+    /* a dip of one update is averaged away */
+    test_updates(TEST_PACK_MV - TEST_DIP_MV, 1U);
+    test_updates(TEST_PACK_MV, TEST_SETTLE_UPDATES);
+    host_expect(record_ps->sessionMinMilliVolt_ui16 > (TEST_PACK_MV - STATS_SAVE_STEP_MV), "dip of %u mV gave a minimum of %u mV",
+                TEST_DIP_MV, record_ps->sessionMinMilliVolt_ui16);
+    host_expect(record_ps->sequence_ui16 == sequence_ui16, "dip of %u mV saved", TEST_DIP_MV);
+
+    /* a pack that stays lower is saved once per step */
+    test_updates(TEST_PACK_MV - STATS_SAVE_STEP_MV, TEST_SETTLE_UPDATES);
+    host_expect(record_ps->sessionMinMilliVolt_ui16 == (TEST_PACK_MV - STATS_SAVE_STEP_MV), "session minimum %u mV after a step",
+                record_ps->sessionMinMilliVolt_ui16);
+    host_expect(record_ps->sequence_ui16 == (uint16)(sequence_ui16 + 1U), "a step of %u mV saved %u times", STATS_SAVE_STEP_MV,
+                (uint16)(record_ps->sequence_ui16 - sequence_ui16));
+
+    /* the session minimum becomes the one of the last session */
+    stats_init();
+    host_expect(record_ps->powerOnCount_ui16 == 2U, "power on count %u after the second power on", record_ps->powerOnCount_ui16);
+    host_expect(record_ps->lastSessionMinMilliVolt_ui16 == (TEST_PACK_MV - STATS_SAVE_STEP_MV), "last session minimum %u mV",
+                record_ps->lastSessionMinMilliVolt_ui16);
+
+    return host_testResult("stats");
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+static void test_updates(uint16 packMilliVolt_ui16, uint16 count_ui16)
+{
+    uint16 update_ui16;
+
+    for (update_ui16 = 0; update_ui16 < count_ui16; update_ui16++)
+    {
+        stats_update(packMilliVolt_ui16, 50U, TEST_CYCLE_MS);
+    }
+}
+
+
+/* ************************************ E O F *************************************************** */
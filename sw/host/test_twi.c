@@ -0,0 +1,284 @@
+/* *************************************************************************************************
+ * file:        test_twi.c
+ *
+ *          Host test of the twi slave register file, atmega328p only.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *
+ * notes:
+ *          the test plays the hardware and the bus master: it puts a status code into TWSR,
+ *          calls TWI_vect() and takes the byte the slave put into TWDR. between the bytes of
+ *          a read it runs telemetry_update() as the main loop would, up to three times per
+ *          byte. every register image that telemetry_update() publishes is copied right after
+ *          the publish, indexed by its SEQUENCE. a read must give exactly the image that was
+ *          the front buffer at its address byte, no byte of a later one. at the end a read
+ *          pauses TWI_SLAVE_TIMEOUT_MS and goes on, a longer pause drops it. the exit code
+ *          is 0 if all checks passed.
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <stddef.h>
+#include <string.h>
+#include <avr/io.h>
+#include <compat/twi.h>
+#include "host_test.h"
+#include "twi/twi.h"
+#include "telemetry/telemetry.h"
+#include "stack/stack.h"
+#include "timer/timer.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* reads of the whole register file, each with another pattern of updates */
+#define TEST_READS                  (64U)
+
+/* a read past the register file gets 0xFF */
+#define TEST_READ_PAST              (2U)
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+void TWI_vect(void);
+
+static void test_event(uint8 status_ui8);
+static Std_ReturnType test_update(void);
+static void test_read(uint8 pointer_ui8, uint8 length_ui8, uint8 pattern_ui8);
+static void test_registerFile(void);
+static void test_pointer(void);
+static void test_slaveTimeout(void);
+
+
+/* ------------------------------------ GLOBAL VARIABLES ---------------------------------------- */
+
+volatile uint8_t SREG;
+volatile uint8_t TWBR;
+volatile uint8_t TWSR;
+volatile uint8_t TWAR;
+volatile uint8_t TWDR;
+volatile uint8_t TWCR;
+volatile uint8_t PORTC;
+volatile uint8_t DDRC;
+volatile uint8_t PINC;
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static uint8 test_images_aa[256][TELEMETRY_REG_SIZE];   // published images by SEQUENCE
+static uint8 test_published_ui8;                        // SEQUENCE of the front buffer
+static uint16 test_updates_ui16;                        // calls of telemetry_update()
+static uint16 test_dropped_ui16;                        // of them E_NOT_OK
+static uint16 test_publishedInRead_ui16;                // of them E_OK while a read ran
+static uint16 test_usageScans_ui16;                     // calls of stack_getUsage()
+static uint16 test_pause_ui16;                          // ticks that passed without an update
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+int main(void)
+{
+    twi_init();
+    host_expect(TWAR == (uint8)(TWI_SLAVE_ADDRESS << 1), "own address 0x%02X", TWAR);
+
+    /* the first image, before any read */
+    host_expect(test_update() == E_OK, "first update dropped");
+
+    test_registerFile();
+    test_pointer();
+
+    host_expect(test_dropped_ui16 != 0U, "no update ever found the back buffer latched");
+    host_expect(test_publishedInRead_ui16 != 0U, "no update was published while a read ran");
+    host_expect(twi_isIdle() == TRUE, "bus not idle at the end");
+
+    /* one tick per update, the sram is scanned once per second of them */
+    host_expect((test_usageScans_ui16 >= (test_updates_ui16 / 1000U)) && (test_usageScans_ui16 <= (1U + test_updates_ui16 / 1000U)),
+                "%u sram scans in %u updates", test_usageScans_ui16, test_updates_ui16);
+
+    test_slaveTimeout();
+
+    return host_testResult("twi");
+}
+
+
+/* ------------------------------------ TIMER AND STACK OF THE HOST ----------------------------- */
+
+timer_TickType timer_getTicks(void)
+{
+    return (timer_TickType)(test_updates_ui16 + test_pause_ui16);
+}
+
+timer_TickType timer_elapsed(timer_TickType since_ui16)
+{
+    return (timer_TickType)(timer_getTicks() - since_ui16);
+}
+
+uint16 timer_getStamp(void)
+{
+    return 0;
+}
+
+void stack_getUsage(stack_UsageType *usage_ps)
+{
+    test_usageScans_ui16++;
+    usage_ps->staticBytes_ui16 = 0;
+    usage_ps->stackMaxBytes_ui16 = 0;
+    usage_ps->freeBytes_ui16 = 0;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+/* one bus event as the hardware reports it */
+static void test_event(uint8 status_ui8)
+{
+    TWSR = status_ui8;
+    TWI_vect();
+}
+
+/* one update of the main loop, the values change with every call. keeps a copy of what it
+ * published, a dropped update must not have had a buffer.
+ */
+static Std_ReturnType test_update(void)
+{
+    uint8 *registers_pui8 = twi_slaveGetRegisters();
+    uint8 cells_ui8 = (uint8)(1U + (test_updates_ui16 % BALANCE_MAX_CELLS));
+    Std_ReturnType result = telemetry_update((uint16)(3000U + 37U * test_updates_ui16), cells_ui8,
+                                             (uint8)(test_updates_ui16 % 101U), NULL);
+
+    test_updates_ui16++;
+    if (result == E_OK)
+    {
+        host_expect(registers_pui8 != NULL, "update %u published without a buffer", test_updates_ui16);
+        if (registers_pui8 != NULL)
+        {
+            test_published_ui8 = registers_pui8[TELEMETRY_REG_SEQUENCE];
+            memcpy(test_images_aa[test_published_ui8], registers_pui8, TELEMETRY_REG_SIZE);
+        }
+    }
+    else
+    {
+        host_expect(registers_pui8 == NULL, "update %u dropped with a free buffer", test_updates_ui16);
+        test_dropped_ui16++;
+    }
+    return result;
+}
+
+/* a write of the register pointer, a repeated start and a read of length_ui8 bytes. before
+ * every byte (pattern + byte) % 4 updates run, 3 of 4 patterns get at least one.
+ */
+static void test_read(uint8 pointer_ui8, uint8 length_ui8, uint8 pattern_ui8)
+{
+    uint8 read_aui8[TWI_SLAVE_REGISTER_SIZE + TEST_READ_PAST];
+    uint8 expected_ui8;
+    uint8 byte_ui8;
+    uint8 update_ui8;
+
+    test_event(TW_SR_SLA_ACK);
+    host_expect(twi_isIdle() == FALSE, "slave write not active");
+    TWDR = pointer_ui8;
+    test_event(TW_SR_DATA_ACK);
+    host_expect((TWCR & (1 << TWEA)) != 0U, "pointer byte not acknowledged");
+
+    test_event(TW_ST_SLA_ACK);
+    expected_ui8 = test_published_ui8;
+    read_aui8[0] = TWDR;
+    for (byte_ui8 = 1; byte_ui8 < length_ui8; byte_ui8++)
+    {
+        for (update_ui8 = 0; update_ui8 < (uint8)((pattern_ui8 + byte_ui8) % 4U); update_ui8++)
+        {
+            if (test_update() == E_OK)
+            {
+                test_publishedInRead_ui16++;
+            }
+        }
+        test_event(TW_ST_DATA_ACK);
+        read_aui8[byte_ui8] = TWDR;
+    }
+    test_event(TW_ST_DATA_NACK);
+    host_expect(twi_isIdle() == TRUE, "slave still active after the read");
+    host_expect((TWCR & (1 << TWEA)) != 0U, "own address no longer acknowledged");
+
+    /* the image that was in front at the address byte, whole */
+    for (byte_ui8 = 0; byte_ui8 < length_ui8; byte_ui8++)
+    {
+        uint16 register_ui16 = (uint16)(pointer_ui8 + byte_ui8);
+        uint8 want_ui8 = (register_ui16 < TELEMETRY_REG_SIZE) ? test_images_aa[expected_ui8][register_ui16] : 0xFFU;
+
+        host_expect(read_aui8[byte_ui8] == want_ui8, "read %u from 0x%02X: register 0x%02X is 0x%02X, image %u has 0x%02X",
+                    pattern_ui8, pointer_ui8, register_ui16, read_aui8[byte_ui8], expected_ui8, want_ui8);
+    }
+
+    /* the latch is gone, the next update gets a buffer */
+    host_expect(test_update() == E_OK, "update after read %u dropped", pattern_ui8);
+}
+
+/* whole reads with updates between the bytes */
+static void test_registerFile(void)
+{
+    uint8 read_ui8;
+
+    for (read_ui8 = 0; read_ui8 < TEST_READS; read_ui8++)
+    {
+        test_read(TELEMETRY_REG_ID, TELEMETRY_REG_SIZE, read_ui8);
+    }
+}
+
+/* reads from other pointers and past the end, a slave write alone only moves the pointer */
+static void test_pointer(void)
+{
+    test_read(TELEMETRY_REG_SEQUENCE, 4U, 1U);
+    test_read(TELEMETRY_REG_PACK_MV, 2U, 2U);
+    test_read(TELEMETRY_REG_PERF_LOOPS, (uint8)(TELEMETRY_REG_SIZE - TELEMETRY_REG_PERF_LOOPS + TEST_READ_PAST), 3U);
+
+    test_event(TW_SR_SLA_ACK);
+    TWDR = TELEMETRY_REG_CELL_MV;
+    test_event(TW_SR_DATA_ACK);
+    TWDR = 0x00U;
+    test_event(TW_SR_DATA_ACK);
+    test_event(TW_SR_STOP);
+    host_expect(twi_isIdle() == TRUE, "slave still active after the write");
+
+    test_event(TW_ST_SLA_ACK);
+    host_expect(TWDR == test_images_aa[test_published_ui8][TELEMETRY_REG_CELL_MV], "second byte of a write moved the pointer");
+    test_event(TW_ST_LAST_DATA);
+    host_expect(twi_isIdle() == TRUE, "slave still active after the last byte");
+}
+
+
+/* a master may pause inside a read as long as SMBus allows, one tick more ends the read */
+static void test_slaveTimeout(void)
+{
+    uint16 errors_ui16 = twi_getErrorCount();
+
+    test_event(TW_SR_SLA_ACK);
+    TWDR = TELEMETRY_REG_ID;
+    test_event(TW_SR_DATA_ACK);
+    test_event(TW_ST_SLA_ACK);
+
+    test_pause_ui16 += TWI_TIMEOUT_MS + 1U;
+    twi_checkTimeout();
+    host_expect(twi_isIdle() == FALSE, "read dropped after the master timeout of %u ms", TWI_TIMEOUT_MS + 1U);
+    test_pause_ui16 += TWI_SLAVE_TIMEOUT_MS - (TWI_TIMEOUT_MS + 1U);
+    twi_checkTimeout();
+    host_expect(twi_isIdle() == FALSE, "read dropped after a pause of %u ms", TWI_SLAVE_TIMEOUT_MS);
+    test_event(TW_ST_DATA_ACK);
+    host_expect(TWDR == test_images_aa[test_published_ui8][TELEMETRY_REG_ID + 1U], "read broken by a pause of %u ms",
+                TWI_SLAVE_TIMEOUT_MS);
+
+    test_pause_ui16 += TWI_SLAVE_TIMEOUT_MS + 1U;
+    twi_checkTimeout();
+    host_expect(twi_isIdle() == TRUE, "read kept after a pause of %u ms", TWI_SLAVE_TIMEOUT_MS + 1U);
+    host_expect(twi_getErrorCount() == (uint16)(errors_ui16 + 1U), "%u errors for the dropped read",
+                twi_getErrorCount() - errors_ui16);
+    host_expect((TWCR & (1 << TWEA)) != 0U, "own address no longer acknowledged after the timeout");
+}
+
+/* ************************************ E O F *************************************************** */
@@ -0,0 +1,802 @@
+/* *************************************************************************************************
+ * file:        tolerance.c
+ *
+ *          Monte-Carlo tolerance analysis of the cell switch and the pack divider, host only.
+ *
+ * author:      agent
+ * date:        19.10.2026
+ * version:     0.1   worky, testing
+ *
+ * file history:
+ *          19.10.2026  agent file created, basic version
+ *          19.10.2026  agent switch windows cut half way to their neighbours
+ *          19.10.2026  agent half the hysteresis band of the firmware around a threshold
+ *          19.10.2026  agent the same tables for any number of threads checked by "make threads"
+ *
+ * notes:
+ *          the nominal values are read from the partlist of the board (hw/partlist.txt), it has
+ *          no tolerances, they come from the command line. resistors and the reference are
+ *          normal with the tolerance as 3 sigma, the adc error is uniform in +- LSB.
+ *
+ *          switch  R12 pulls ADC0 up, each position of S2 pulls it down through one of R6..R11
+ *                  (schematic). the lowest resistor gives the lowest code and is taken as 1 cell.
+ *                  the ladder is ratiometric, R12 and AVCC are both on +3V3, so the schematic
+ *                  gives 1024 * Rn / (Rn + R12): 512 to 931. LIPO_CELL_n are 358 to 650 and no
+ *                  set of closed switches gives them either, the schematic does not explain the
+ *                  codes the firmware was made for. so LIPO_CELL_n are taken as the nominal codes
+ *                  of the board and the schematic only for the spread around them:
+ *                  code = (LIPO_CELL_n + 0.5) * f(Rn, R12) / f(nominal), f = Rn / (Rn + R12).
+ *                  with -g the codes are gain * 1024 * f(Rn, R12) instead, -g 1 is the schematic.
+ *          divider R19 / R20 scale the pack to ADC1 against the supply. a pack half a hysteresis
+ *                  band (hysteresis_digits() of the threshold) above it has to show the upper
+ *                  level, half a band below the lower one, as checkUbatState() decides from
+ *                  scratch.
+ *
+ *          the boards are cut into chunks of TOLERANCE_CHUNK, each chunk seeds its own random
+ *          generator from the seed and its index. every thread starts with an equal range of
+ *          chunks and steals half of the rest of another thread when its own is done, so the
+ *          result does not depend on the number of threads and the threads share nothing but
+ *          the ranges. the counters are summed when all threads are joined. "make threads"
+ *          checks that 1 to 8 threads give the same tables, how the time falls with the cores
+ *          has not been measured yet, see doc/open_items.md.
+ *
+ *          the switch windows are evaluated for every DIGIT_DIFF up to TOLERANCE_MAX_DIFF around
+ *          the firmware codes and around the mean codes of the model, cut half way to their
+ *          neighbours as in checkLipoSwitch(). the suggestion is the smallest window below the
+ *          target probability, next to the largest one that no neighbour cuts.
+ *
+ *          usage: tolerance [-n boards] [-j threads] [-s seed] [-t %] [-T part=%] [-v %]
+ *                           [-a lsb] [-g gain] [-e probability] [-p partlist]
+ *
+ * copyright:   http://creativecommons.org/licenses/by-nc-sa/3.0/
+ **************************************************************************************************/
+/* ------------------------------------ INCLUDES ------------------------------------------------ */
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "hal_host.h"
+#include "indicator/indicator.h"
+#include "soc/soc.h"
+
+
+/* ------------------------------------ DEFINES ------------------------------------------------- */
+
+/* 10 bit codes */
+#define TOLERANCE_CODES             (1024U)
+
+#define TOLERANCE_CHUNK             (16384UL)
+#define TOLERANCE_MAX_THREADS       (256U)
+#define TOLERANCE_MAX_PARTS         (64U)
+#define TOLERANCE_MAX_DIFF          (16U)
+
+/* the tolerance is 3 sigma */
+#define TOLERANCE_SIGMAS            (3.0)
+
+#define TOLERANCE_TWO_PI            (6.283185307179586)
+
+#define TOLERANCE_PULLUP            "R12"
+#define TOLERANCE_LADDER            {"R6", "R7", "R8", "R9", "R10", "R11"}
+#define TOLERANCE_DIVIDER_TOP       "R19"
+#define TOLERANCE_DIVIDER_BOTTOM    "R20"
+
+
+/* ------------------------------------ TYPE DEFINITIONS ---------------------------------------- */
+
+typedef struct
+{
+    char name_ac[16];
+    float64 ohm_f64;
+    float64 sigma_f64;              // relative
+}tolerance_PartType;
+
+typedef struct
+{
+    uint64 state_aui64[4];
+}tolerance_RandomType;
+
+/* one threshold of one cell count */
+typedef struct
+{
+    uint16 code_ui16;               // as setCellThresholds() computes it
+    float64 above_f64;              // exact digits of the pack half a band above and below
+    float64 below_f64;
+}tolerance_ThresholdType;
+
+typedef struct
+{
+    uint64 switch_aaui64[MAX_NUM_OF_CELLS][TOLERANCE_CODES];
+    uint64 above_aaui64[MAX_NUM_OF_CELLS][NUM_OF_THRESHOLDS];      // read below the threshold
+    uint64 below_aaui64[MAX_NUM_OF_CELLS][NUM_OF_THRESHOLDS];      // read at or above it
+    uint64 boards_ui64;
+}tolerance_CountType;
+
+/* chunks [first, end) of one thread, first in the low half */
+typedef struct
+{
+    uint64 range_ui64;
+    uint8 pad_aui8[56];
+}tolerance_QueueType;
+
+typedef struct
+{
+    pthread_t thread_s;
+    uint32 index_ui32;
+    uint32 chunks_ui32;
+    uint32 stolen_ui32;
+    tolerance_CountType *count_ps;
+}tolerance_WorkerType;
+
+
+/* ------------------------------------ PROTOTYPES ---------------------------------------------- */
+
+static void tolerance_usage(void);
+static float64 tolerance_parseOhm(const char *value_pc);
+static uint8 tolerance_readPartlist(const char *path_pc);
+static tolerance_PartType *tolerance_findPart(const char *name_pc);
+static void tolerance_setup(void);
+static uint64 tolerance_splitmix(uint64 *state_pui64);
+static uint64 tolerance_next(tolerance_RandomType *random_ps);
+static float64 tolerance_uniform(tolerance_RandomType *random_ps);
+static float64 tolerance_normal(tolerance_RandomType *random_ps);
+static float64 tolerance_sample(tolerance_RandomType *random_ps, const tolerance_PartType *part_ps);
+static uint16 tolerance_convert(tolerance_RandomType *random_ps, float64 digits_f64);
+static void tolerance_board(tolerance_RandomType *random_ps, tolerance_CountType *count_ps);
+static void tolerance_runChunk(uint32 chunk_ui32, tolerance_CountType *count_ps);
+static boolean tolerance_take(uint32 queue_ui32, uint32 *chunk_pui32);
+static boolean tolerance_steal(uint32 thief_ui32, uint32 *chunk_pui32);
+static void *tolerance_worker(void *worker_pv);
+static float64 tolerance_wrong(const uint16 *centre_pui16, uint8 diff_ui8, uint8 cell_ui8);
+static void tolerance_report(float64 seconds_f64);
+
+
+/* ------------------------------------ PRIVATE VARIABLES --------------------------------------- */
+
+static const uint16 tolerance_nominal_aui16[MAX_NUM_OF_CELLS] =
+{
+    LIPO_CELL_1, LIPO_CELL_2, LIPO_CELL_3, LIPO_CELL_4, LIPO_CELL_5, LIPO_CELL_6
+};
+
+static tolerance_PartType tolerance_parts_as[TOLERANCE_MAX_PARTS];
+static uint8 tolerance_numParts_ui8;
+
+/* the model, ladder in cell order */
+static const tolerance_PartType *tolerance_pullup_ps;
+static const tolerance_PartType *tolerance_ladder_aps[MAX_NUM_OF_CELLS];
+static const tolerance_PartType *tolerance_top_ps;
+static const tolerance_PartType *tolerance_bottom_ps;
+static tolerance_ThresholdType tolerance_thresholds_aas[MAX_NUM_OF_CELLS][NUM_OF_THRESHOLDS];
+static float64 tolerance_gain_f64;
+static float64 tolerance_scale_af64[MAX_NUM_OF_CELLS];       // code = scale * f(Rn, R12)
+static float64 tolerance_ratio_f64;
+
+/* command line */
+static uint64 tolerance_boards_ui64 = 10000000ULL;
+static uint32 tolerance_threads_ui32;
+static uint64 tolerance_seed_ui64 = 1U;
+static float64 tolerance_resistor_f64 = 1.0;
+static float64 tolerance_reference_f64 = 2.0;
+static float64 tolerance_adcLsb_f64 = 2.0;
+static float64 tolerance_target_f64 = 1e-6;
+static const char *tolerance_partlist_pc = "../../hw/partlist.txt";
+
+static uint32 tolerance_numChunks_ui32;
+static tolerance_QueueType tolerance_queues_as[TOLERANCE_MAX_THREADS] __attribute__((aligned(64)));
+static tolerance_WorkerType tolerance_workers_as[TOLERANCE_MAX_THREADS];
+static tolerance_CountType tolerance_total_s;
+
+
+/* ------------------------------------ GLOBAL FUNCTIONS ---------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    const char *overrides_apc[TOLERANCE_MAX_PARTS];
+    uint8 numOverrides_ui8 = 0;
+    struct timespec start_s;
+    struct timespec end_s;
+    uint32 thread_ui32;
+    uint32 first_ui32;
+    uint8 override_ui8;
+    int option;
+
+    tolerance_threads_ui32 = (uint32)sysconf(_SC_NPROCESSORS_ONLN);
+    while ((option = getopt(argc, argv, "n:j:s:t:T:v:a:g:e:p:h")) != -1)
+    {
+        switch (option)
+        {
+            case 'n': tolerance_boards_ui64 = strtoull(optarg, NULL, 0); break;
+            case 'j': tolerance_threads_ui32 = (uint32)strtoul(optarg, NULL, 0); break;
+            case 's': tolerance_seed_ui64 = strtoull(optarg, NULL, 0); break;
+            case 't': tolerance_resistor_f64 = atof(optarg); break;
+            case 'v': tolerance_reference_f64 = atof(optarg); break;
+            case 'a': tolerance_adcLsb_f64 = atof(optarg); break;
+            case 'g': tolerance_gain_f64 = atof(optarg); break;
+            case 'e': tolerance_target_f64 = atof(optarg); break;
+            case 'p': tolerance_partlist_pc = optarg; break;
+            case 'T':
+                if (numOverrides_ui8 < TOLERANCE_MAX_PARTS)
+                {
+                    overrides_apc[numOverrides_ui8++] = optarg;
+                }
+                break;
+            default: tolerance_usage(); return 2;
+        }
+    }
+    if ((tolerance_boards_ui64 == 0U) || (tolerance_threads_ui32 == 0U))
+    {
+        tolerance_usage();
+        return 2;
+    }
+    if (tolerance_threads_ui32 > TOLERANCE_MAX_THREADS)
+    {
+        tolerance_threads_ui32 = TOLERANCE_MAX_THREADS;
+    }
+
+    if (tolerance_readPartlist(tolerance_partlist_pc) != E_OK)
+    {
+        return 2;
+    }
+    for (override_ui8 = 0; override_ui8 < numOverrides_ui8; override_ui8++)
+    {
+        char name_ac[16];
+        float64 percent_f64;
+        tolerance_PartType *part_ps;
+
+        if ((sscanf(overrides_apc[override_ui8], "%15[^=]=%lf", name_ac, &percent_f64) != 2) ||
+            ((part_ps = tolerance_findPart(name_ac)) == NULL))
+        {
+            fprintf(stderr, "tolerance: bad override %s\n", overrides_apc[override_ui8]);
+            return 2;
+        }
+        part_ps->sigma_f64 = percent_f64 / 100.0 / TOLERANCE_SIGMAS;
+    }
+
+    hal_init();
+    soc_init();
+#if (INDICATOR_SETTINGS == STD_ON)
+    settings_init();
+#endif
+    tolerance_setup();
+    if (tolerance_pullup_ps == NULL)
+    {
+        return 2;
+    }
+
+    /* equal ranges, the rest goes to the first threads */
+    tolerance_numChunks_ui32 = (uint32)((tolerance_boards_ui64 + TOLERANCE_CHUNK - 1U) / TOLERANCE_CHUNK);
+    first_ui32 = 0;
+    for (thread_ui32 = 0; thread_ui32 < tolerance_threads_ui32; thread_ui32++)
+    {
+        uint32 size_ui32 = (tolerance_numChunks_ui32 / tolerance_threads_ui32) +
+                           ((thread_ui32 < (tolerance_numChunks_ui32 % tolerance_threads_ui32)) ? 1U : 0U);
+
+        tolerance_queues_as[thread_ui32].range_ui64 = ((uint64)(first_ui32 + size_ui32) << 32) | first_ui32;
+        first_ui32 += size_ui32;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start_s);
+    for (thread_ui32 = 0; thread_ui32 < tolerance_threads_ui32; thread_ui32++)
+    {
+        tolerance_WorkerType *worker_ps = &tolerance_workers_as[thread_ui32];
+
+        worker_ps->index_ui32 = thread_ui32;
+        worker_ps->count_ps = calloc(1, sizeof(tolerance_CountType));
+        if ((worker_ps->count_ps == NULL) || (pthread_create(&worker_ps->thread_s, NULL, tolerance_worker, worker_ps) != 0))
+        {
+            fprintf(stderr, "tolerance: no thread %lu\n", (unsigned long)thread_ui32);
+            return 2;
+        }
+    }
+    for (thread_ui32 = 0; thread_ui32 < tolerance_threads_ui32; thread_ui32++)
+    {
+        const tolerance_CountType *count_ps = tolerance_workers_as[thread_ui32].count_ps;
+        const uint64 *from_pui64 = (const uint64 *)count_ps;
+        uint64 *to_pui64 = (uint64 *)&tolerance_total_s;
+        size_t word_ui32;
+
+        pthread_join(tolerance_workers_as[thread_ui32].thread_s, NULL);
+        for (word_ui32 = 0; word_ui32 < (sizeof(tolerance_CountType) / sizeof(uint64)); word_ui32++)
+        {
+            to_pui64[word_ui32] += from_pui64[word_ui32];
+        }
+        free(tolerance_workers_as[thread_ui32].count_ps);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end_s);
+
+    tolerance_report((float64)(end_s.tv_sec - start_s.tv_sec) + ((float64)(end_s.tv_nsec - start_s.tv_nsec) / 1e9));
+    return 0;
+}
+
+
+/* ------------------------------------ PRIVATE FUNCTIONS --------------------------------------- */
+
+static void tolerance_usage(void)
+{
+    fprintf(stderr, "usage: tolerance [-n boards] [-j threads] [-s seed] [-t %%] [-T part=%%] [-v %%]\n"
+                    "                 [-a lsb] [-g gain] [-e probability] [-p partlist]\n"
+                    "  -t  resistor tolerance in %%, default 1\n"
+                    "  -T  tolerance of one part, e.g. -T R12=0.1\n"
+                    "  -v  tolerance of the supply the pack is read against in %%, default 2\n"
+                    "  -a  adc error in +- LSB, default 2\n"
+                    "  -g  switch codes from the schematic times gain, default around LIPO_CELL_n\n"
+                    "  -e  misclassification target of the suggestion, default 1e-6\n");
+}
+
+/* 100k, 470R, 4k7, 1M */
+static float64 tolerance_parseOhm(const char *value_pc)
+{
+    char *end_pc;
+    float64 ohm_f64 = strtod(value_pc, &end_pc);
+    float64 scale_f64;
+
+    switch (*end_pc)
+    {
+        case 'R': case 'r': scale_f64 = 1.0; break;
+        case 'k': case 'K': scale_f64 = 1e3; break;
+        case 'M': scale_f64 = 1e6; break;
+        case '\0': return ohm_f64;
+        default: return 0.0;
+    }
+    end_pc++;
+    if ((*end_pc >= '0') && (*end_pc <= '9'))
+    {
+        ohm_f64 += strtod(end_pc, NULL) / pow(10.0, (float64)strspn(end_pc, "0123456789"));
+    }
+    return ohm_f64 * scale_f64;
+}
+
+/* the resistors of an eagle partlist: Part Value Package Library Position Orientation */
+static uint8 tolerance_readPartlist(const char *path_pc)
+{
+    char line_ac[256];
+    FILE *file_ps = fopen(path_pc, "r");
+
+    if (file_ps == NULL)
+    {
+        fprintf(stderr, "tolerance: cannot open %s\n", path_pc);
+        return E_NOT_OK;
+    }
+    while ((fgets(line_ac, sizeof(line_ac), file_ps) != NULL) && (tolerance_numParts_ui8 < TOLERANCE_MAX_PARTS))
+    {
+        tolerance_PartType *part_ps = &tolerance_parts_as[tolerance_numParts_ui8];
+        char value_ac[16];
+
+        if ((sscanf(line_ac, "%15s %15s", part_ps->name_ac, value_ac) == 2) &&
+            (part_ps->name_ac[0] == 'R') && (part_ps->name_ac[1] >= '0') && (part_ps->name_ac[1] <= '9'))
+        {
+            part_ps->ohm_f64 = tolerance_parseOhm(value_ac);
+            part_ps->sigma_f64 = tolerance_resistor_f64 / 100.0 / TOLERANCE_SIGMAS;
+            if (part_ps->ohm_f64 > 0.0)
+            {
+                tolerance_numParts_ui8++;
+            }
+        }
+    }
+    fclose(file_ps);
+    return E_OK;
+}
+
+static tolerance_PartType *tolerance_findPart(const char *name_pc)
+{
+    uint8 part_ui8;
+
+    for (part_ui8 = 0; part_ui8 < tolerance_numParts_ui8; part_ui8++)
+    {
+        if (strcmp(tolerance_parts_as[part_ui8].name_ac, name_pc) == 0)
+        {
+            return &tolerance_parts_as[part_ui8];
+        }
+    }
+    fprintf(stderr, "tolerance: %s not in the partlist\n", name_pc);
+    return NULL;
+}
+
+/* the ladder in cell order, the gain and the thresholds. leaves the pullup NULL on error */
+static void tolerance_setup(void)
+{
+    static const char *ladder_apc[MAX_NUM_OF_CELLS] = TOLERANCE_LADDER;
+    const tolerance_PartType *pullup_ps = tolerance_findPart(TOLERANCE_PULLUP);
+    uint8 cell_ui8;
+    uint8 level_ui8;
+
+    tolerance_top_ps = tolerance_findPart(TOLERANCE_DIVIDER_TOP);
+    tolerance_bottom_ps = tolerance_findPart(TOLERANCE_DIVIDER_BOTTOM);
+    for (cell_ui8 = 0; cell_ui8 < MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        const tolerance_PartType *part_ps = tolerance_findPart(ladder_apc[cell_ui8]);
+        uint8 slot_ui8 = cell_ui8;
+
+        if (part_ps == NULL)
+        {
+            return;
+        }
+        /* insertion by value */
+        while ((slot_ui8 > 0U) && (tolerance_ladder_aps[slot_ui8 - 1U]->ohm_f64 > part_ps->ohm_f64))
+        {
+            tolerance_ladder_aps[slot_ui8] = tolerance_ladder_aps[slot_ui8 - 1U];
+            slot_ui8--;
+        }
+        tolerance_ladder_aps[slot_ui8] = part_ps;
+    }
+    if ((pullup_ps == NULL) || (tolerance_top_ps == NULL) || (tolerance_bottom_ps == NULL))
+    {
+        return;
+    }
+
+    for (cell_ui8 = 0; cell_ui8 < MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        float64 ohm_f64 = tolerance_ladder_aps[cell_ui8]->ohm_f64;
+
+        if (tolerance_gain_f64 > 0.0)
+        {
+            tolerance_scale_af64[cell_ui8] = tolerance_gain_f64 * TOLERANCE_CODES;
+        }
+        else
+        {
+            /* the middle of the nominal code, the conversion truncates */
+            tolerance_scale_af64[cell_ui8] = (tolerance_nominal_aui16[cell_ui8] + 0.5) * (ohm_f64 + pullup_ps->ohm_f64) / ohm_f64;
+        }
+    }
+
+    tolerance_ratio_f64 = tolerance_bottom_ps->ohm_f64 / (tolerance_top_ps->ohm_f64 + tolerance_bottom_ps->ohm_f64);
+    for (cell_ui8 = 0; cell_ui8 < MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        for (level_ui8 = 0; level_ui8 < NUM_OF_THRESHOLDS; level_ui8++)
+        {
+            tolerance_ThresholdType *threshold_ps = &tolerance_thresholds_aas[cell_ui8][level_ui8];
+            uint32 milliVolt_ui32 = (uint32)soc_getCellMilliVolt(indicator_thresholdPercent(level_ui8)) * (cell_ui8 + 1U);
+            float64 exact_f64 = (float64)milliVolt_ui32 * ADC_DIGITS / UBAT_MILLIVOLT_SCALE;
+
+            threshold_ps->code_ui16 = ubat_millivolt_to_digit(milliVolt_ui32);
+            threshold_ps->above_f64 = exact_f64 + hysteresis_digits(threshold_ps->code_ui16) / 2.0;
+            threshold_ps->below_f64 = exact_f64 - hysteresis_digits(threshold_ps->code_ui16) / 2.0;
+        }
+    }
+    tolerance_pullup_ps = pullup_ps;
+}
+
+static uint64 tolerance_splitmix(uint64 *state_pui64)
+{
+    uint64 z_ui64 = (*state_pui64 += 0x9E3779B97F4A7C15ULL);
+
+    z_ui64 = (z_ui64 ^ (z_ui64 >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z_ui64 = (z_ui64 ^ (z_ui64 >> 27)) * 0x94D049BB133111EBULL;
+    return z_ui64 ^ (z_ui64 >> 31);
+}
+
+/* xoshiro256** */
+static uint64 tolerance_next(tolerance_RandomType *random_ps)
+{
+    uint64 *s_pui64 = random_ps->state_aui64;
+    uint64 result_ui64 = s_pui64[1] * 5U;
+    uint64 t_ui64 = s_pui64[1] << 17;
+
+    result_ui64 = ((result_ui64 << 7) | (result_ui64 >> 57)) * 9U;
+    s_pui64[2] ^= s_pui64[0];
+    s_pui64[3] ^= s_pui64[1];
+    s_pui64[1] ^= s_pui64[2];
+    s_pui64[0] ^= s_pui64[3];
+    s_pui64[2] ^= t_ui64;
+    s_pui64[3] = (s_pui64[3] << 45) | (s_pui64[3] >> 19);
+    return result_ui64;
+}
+
+/* (0, 1) */
+static float64 tolerance_uniform(tolerance_RandomType *random_ps)
+{
+    return ((float64)(tolerance_next(random_ps) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/* box muller */
+static float64 tolerance_normal(tolerance_RandomType *random_ps)
+{
+    float64 radius_f64 = sqrt(-2.0 * log(tolerance_uniform(random_ps)));
+
+    return radius_f64 * cos(TOLERANCE_TWO_PI * tolerance_uniform(random_ps));
+}
+
+static float64 tolerance_sample(tolerance_RandomType *random_ps, const tolerance_PartType *part_ps)
+{
+    return part_ps->ohm_f64 * (1.0 + (part_ps->sigma_f64 * tolerance_normal(random_ps)));
+}
+
+/* the analog value in digits to the 10 bit result */
+static uint16 tolerance_convert(tolerance_RandomType *random_ps, float64 digits_f64)
+{
+    digits_f64 += tolerance_adcLsb_f64 * ((2.0 * tolerance_uniform(random_ps)) - 1.0);
+    if (digits_f64 < 0.0)
+    {
+        return 0;
+    }
+    if (digits_f64 >= (TOLERANCE_CODES - 1U))
+    {
+        return TOLERANCE_CODES - 1U;
+    }
+    return (uint16)digits_f64;
+}
+
+static void tolerance_board(tolerance_RandomType *random_ps, tolerance_CountType *count_ps)
+{
+    float64 pullup_f64 = tolerance_sample(random_ps, tolerance_pullup_ps);
+    float64 top_f64 = tolerance_sample(random_ps, tolerance_top_ps);
+    float64 bottom_f64 = tolerance_sample(random_ps, tolerance_bottom_ps);
+    float64 gain_f64;
+    uint8 cell_ui8;
+    uint8 level_ui8;
+
+    for (cell_ui8 = 0; cell_ui8 < MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        float64 ohm_f64 = tolerance_sample(random_ps, tolerance_ladder_aps[cell_ui8]);
+        uint16 code_ui16 = tolerance_convert(random_ps, tolerance_scale_af64[cell_ui8] * ohm_f64 / (ohm_f64 + pullup_f64));
+
+        count_ps->switch_aaui64[cell_ui8][code_ui16]++;
+    }
+
+    /* a higher supply reads lower */
+    gain_f64 = (bottom_f64 / (top_f64 + bottom_f64)) / tolerance_ratio_f64;
+    gain_f64 /= 1.0 + (tolerance_reference_f64 / 100.0 / TOLERANCE_SIGMAS * tolerance_normal(random_ps));
+    for (cell_ui8 = 0; cell_ui8 < MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        for (level_ui8 = 0; level_ui8 < NUM_OF_THRESHOLDS; level_ui8++)
+        {
+            const tolerance_ThresholdType *threshold_ps = &tolerance_thresholds_aas[cell_ui8][level_ui8];
+
+            count_ps->above_aaui64[cell_ui8][level_ui8] +=
+                (tolerance_convert(random_ps, threshold_ps->above_f64 * gain_f64) < threshold_ps->code_ui16);
+            count_ps->below_aaui64[cell_ui8][level_ui8] +=
+                (tolerance_convert(random_ps, threshold_ps->below_f64 * gain_f64) >= threshold_ps->code_ui16);
+        }
+    }
+    count_ps->boards_ui64++;
+}
+
+static void tolerance_runChunk(uint32 chunk_ui32, tolerance_CountType *count_ps)
+{
+    tolerance_RandomType random_s;
+    uint64 seed_ui64 = tolerance_seed_ui64 ^ ((uint64)chunk_ui32 << 32);
+    uint64 board_ui64 = (uint64)chunk_ui32 * TOLERANCE_CHUNK;
+    uint64 end_ui64 = board_ui64 + TOLERANCE_CHUNK;
+    uint8 word_ui8;
+
+    for (word_ui8 = 0; word_ui8 < 4U; word_ui8++)
+    {
+        random_s.state_aui64[word_ui8] = tolerance_splitmix(&seed_ui64);
+    }
+    if (end_ui64 > tolerance_boards_ui64)
+    {
+        end_ui64 = tolerance_boards_ui64;
+    }
+    for (; board_ui64 < end_ui64; board_ui64++)
+    {
+        tolerance_board(&random_s, count_ps);
+    }
+}
+
+/* the first chunk of a range */
+static boolean tolerance_take(uint32 queue_ui32, uint32 *chunk_pui32)
+{
+    uint64 *range_pui64 = &tolerance_queues_as[queue_ui32].range_ui64;
+    uint64 range_ui64 = __atomic_load_n(range_pui64, __ATOMIC_ACQUIRE);
+
+    while ((uint32)range_ui64 < (uint32)(range_ui64 >> 32))
+    {
+        if (__atomic_compare_exchange_n(range_pui64, &range_ui64, range_ui64 + 1U, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            *chunk_pui32 = (uint32)range_ui64;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* the upper half of the first range that is left becomes the own one. a chunk is never
+ * put back, so a range once seen does not come again and the compare exchange is safe */
+static boolean tolerance_steal(uint32 thief_ui32, uint32 *chunk_pui32)
+{
+    uint32 offset_ui32;
+
+    for (offset_ui32 = 1; offset_ui32 < tolerance_threads_ui32; offset_ui32++)
+    {
+        uint32 victim_ui32 = (thief_ui32 + offset_ui32) % tolerance_threads_ui32;
+        uint64 *range_pui64 = &tolerance_queues_as[victim_ui32].range_ui64;
+        uint64 range_ui64 = __atomic_load_n(range_pui64, __ATOMIC_ACQUIRE);
+
+        while ((uint32)range_ui64 < (uint32)(range_ui64 >> 32))
+        {
+            uint32 first_ui32 = (uint32)range_ui64;
+            uint32 end_ui32 = (uint32)(range_ui64 >> 32);
+            uint32 split_ui32 = end_ui32 - ((end_ui32 - first_ui32 + 1U) / 2U);
+
+            if (__atomic_compare_exchange_n(range_pui64, &range_ui64, ((uint64)split_ui32 << 32) | first_ui32, FALSE,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            {
+                __atomic_store_n(&tolerance_queues_as[thief_ui32].range_ui64, ((uint64)end_ui32 << 32) | (split_ui32 + 1U),
+                                 __ATOMIC_RELEASE);
+                tolerance_workers_as[thief_ui32].stolen_ui32 += end_ui32 - split_ui32;
+                *chunk_pui32 = split_ui32;
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+static void *tolerance_worker(void *worker_pv)
+{
+    tolerance_WorkerType *worker_ps = worker_pv;
+    uint32 chunk_ui32;
+
+    while (tolerance_take(worker_ps->index_ui32, &chunk_ui32) || tolerance_steal(worker_ps->index_ui32, &chunk_ui32))
+    {
+        tolerance_runChunk(chunk_ui32, worker_ps->count_ps);
+        worker_ps->chunks_ui32++;
+    }
+    return NULL;
+}
+
+/* share of the boards whose code of the cell falls outside its window or into an earlier one */
+static float64 tolerance_wrong(const uint16 *centre_pui16, uint8 diff_ui8, uint8 cell_ui8)
+{
+    const uint64 *count_pui64 = tolerance_total_s.switch_aaui64[cell_ui8];
+    uint64 wrong_ui64 = 0;
+    uint16 code_ui16;
+
+    for (code_ui16 = 0; code_ui16 < TOLERANCE_CODES; code_ui16++)
+    {
+        uint8 found_ui8 = MAX_NUM_OF_CELLS;
+        uint8 window_ui8;
+
+        for (window_ui8 = 0; window_ui8 < MAX_NUM_OF_CELLS; window_ui8++)
+        {
+            /* the window is cut half way to its neighbours, as in_switch_window() */
+            uint16 below_ui16 = (window_ui8 > 0U) ? centre_pui16[window_ui8 - 1U] : (uint16)(centre_pui16[0] - 2U * diff_ui8);
+            uint16 above_ui16 = (window_ui8 < (MAX_NUM_OF_CELLS - 1U)) ? centre_pui16[window_ui8 + 1U] :
+                                (uint16)(centre_pui16[window_ui8] + 2U * diff_ui8);
+
+            if (in_between(code_ui16, centre_pui16[window_ui8], diff_ui8) && ((2U * code_ui16) > (below_ui16 + centre_pui16[window_ui8])) &&
+                ((2U * code_ui16) < (centre_pui16[window_ui8] + above_ui16)))
+            {
+                found_ui8 = window_ui8;
+                break;
+            }
+        }
+        wrong_ui64 += (found_ui8 != cell_ui8) ? count_pui64[code_ui16] : 0U;
+    }
+    return (float64)wrong_ui64 / (float64)tolerance_total_s.boards_ui64;
+}
+
+static void tolerance_report(float64 seconds_f64)
+{
+    const float64 boards_f64 = (float64)tolerance_total_s.boards_ui64;
+    const uint16 *centres_apui16[2];
+    uint16 mean_aui16[MAX_NUM_OF_CELLS];
+    uint8 fit_aui8[2] = {0, 0};
+    uint8 apart_aui8[2] = {TOLERANCE_MAX_DIFF, TOLERANCE_MAX_DIFF};
+    uint32 chunks_ui32 = 0;
+    uint32 stolen_ui32 = 0;
+    uint32 thread_ui32;
+    uint8 cell_ui8;
+    uint8 level_ui8;
+    uint8 diff_ui8;
+    uint8 set_ui8;
+
+    for (thread_ui32 = 0; thread_ui32 < tolerance_threads_ui32; thread_ui32++)
+    {
+        chunks_ui32 += tolerance_workers_as[thread_ui32].chunks_ui32;
+        stolen_ui32 += tolerance_workers_as[thread_ui32].stolen_ui32;
+    }
+    printf("%llu boards, %lu threads, %.2f s, %.2f M boards/s, %lu of %lu chunks stolen\n",
+           (unsigned long long)tolerance_total_s.boards_ui64, (unsigned long)tolerance_threads_ui32, seconds_f64,
+           boards_f64 / seconds_f64 / 1e6, (unsigned long)stolen_ui32, (unsigned long)chunks_ui32);
+    printf("resistors %.2f%%, supply %.2f%%, adc +-%.1f LSB, switch codes ", tolerance_resistor_f64, tolerance_reference_f64,
+           tolerance_adcLsb_f64);
+    if (tolerance_gain_f64 > 0.0)
+    {
+        printf("from the schematic times %.4f\n\n", tolerance_gain_f64);
+    }
+    else
+    {
+        printf("around LIPO_CELL_n\n\n");
+    }
+
+    printf("switch  part      ohm   tol  schematic  firmware   mean  sigma    min  max   wrong at DIGIT_DIFF %d\n", DIGIT_DIFF);
+    for (cell_ui8 = 0; cell_ui8 < MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        const tolerance_PartType *part_ps = tolerance_ladder_aps[cell_ui8];
+        const uint64 *count_pui64 = tolerance_total_s.switch_aaui64[cell_ui8];
+        float64 schematic_f64 = TOLERANCE_CODES * part_ps->ohm_f64 / (part_ps->ohm_f64 + tolerance_pullup_ps->ohm_f64);
+        float64 sum_f64 = 0.0;
+        float64 square_f64 = 0.0;
+        uint16 min_ui16 = TOLERANCE_CODES;
+        uint16 max_ui16 = 0;
+        uint16 code_ui16;
+        float64 mean_f64;
+
+        for (code_ui16 = 0; code_ui16 < TOLERANCE_CODES; code_ui16++)
+        {
+            if (count_pui64[code_ui16] != 0U)
+            {
+                sum_f64 += (float64)count_pui64[code_ui16] * code_ui16;
+                square_f64 += (float64)count_pui64[code_ui16] * code_ui16 * code_ui16;
+                min_ui16 = (code_ui16 < min_ui16) ? code_ui16 : min_ui16;
+                max_ui16 = code_ui16;
+            }
+        }
+        mean_f64 = sum_f64 / boards_f64;
+        mean_aui16[cell_ui8] = (uint16)(mean_f64 + 0.5);
+        printf("%u cell  %-6s %7.0f %4.1f%%  %9.1f  %8u  %5.1f  %5.2f  %5u %4u   %.2e\n", cell_ui8 + 1U, part_ps->name_ac,
+               part_ps->ohm_f64, part_ps->sigma_f64 * TOLERANCE_SIGMAS * 100.0, schematic_f64, tolerance_nominal_aui16[cell_ui8],
+               mean_f64, sqrt((square_f64 / boards_f64) - (mean_f64 * mean_f64)), min_ui16, max_ui16,
+               tolerance_wrong(tolerance_nominal_aui16, DIGIT_DIFF, cell_ui8));
+    }
+
+    /* worst cell per window size, around the firmware codes and around the mean codes */
+    centres_apui16[0] = tolerance_nominal_aui16;
+    centres_apui16[1] = mean_aui16;
+    printf("\nDIGIT_DIFF  worst wrong around LIPO_CELL_n   around the mean codes\n");
+    for (diff_ui8 = 1; diff_ui8 <= TOLERANCE_MAX_DIFF; diff_ui8++)
+    {
+        float64 worst_af64[2] = {0.0, 0.0};
+
+        for (set_ui8 = 0; set_ui8 < 2U; set_ui8++)
+        {
+            for (cell_ui8 = 0; cell_ui8 < MAX_NUM_OF_CELLS; cell_ui8++)
+            {
+                float64 wrong_f64 = tolerance_wrong(centres_apui16[set_ui8], diff_ui8, cell_ui8);
+
+                worst_af64[set_ui8] = (wrong_f64 > worst_af64[set_ui8]) ? wrong_f64 : worst_af64[set_ui8];
+                /* open windows n +- d keep their full width while 2d <= distance, then they are cut */
+                if ((cell_ui8 > 0U) && ((2U * diff_ui8) > (uint16)(centres_apui16[set_ui8][cell_ui8] - centres_apui16[set_ui8][cell_ui8 - 1U])) &&
+                    (apart_aui8[set_ui8] >= diff_ui8))
+                {
+                    apart_aui8[set_ui8] = (uint8)(diff_ui8 - 1U);
+                }
+            }
+            if ((fit_aui8[set_ui8] == 0U) && (worst_af64[set_ui8] <= tolerance_target_f64))
+            {
+                fit_aui8[set_ui8] = diff_ui8;
+            }
+        }
+        printf("%10u  %27.2e  %22.2e\n", diff_ui8, worst_af64[0], worst_af64[1]);
+    }
+
+    for (set_ui8 = 0; set_ui8 < 2U; set_ui8++)
+    {
+        printf("%s: ", (set_ui8 == 0U) ? "suggestion around LIPO_CELL_n " : "suggestion around the mean codes");
+        if (fit_aui8[set_ui8] == 0U)
+        {
+            printf("no DIGIT_DIFF up to %u reaches %.0e", TOLERANCE_MAX_DIFF, tolerance_target_f64);
+        }
+        else
+        {
+            printf("DIGIT_DIFF >= %u reaches %.0e", fit_aui8[set_ui8], tolerance_target_f64);
+        }
+        printf(", windows full width up to %u%s\n", apart_aui8[set_ui8], (fit_aui8[set_ui8] != 0U) ? "" : ", tighter parts needed");
+    }
+
+    printf("\nthreshold wrong half a band (%u.%u%% of the threshold, at least %u digits) above / below\n", HYSTERESIS_PERMILLE / 10U,
+           HYSTERESIS_PERMILLE % 10U, HYSTERESIS_MIN_DIGITS);
+    printf("cells");
+    for (level_ui8 = 0; level_ui8 < NUM_OF_THRESHOLDS; level_ui8++)
+    {
+        printf("    %3u%% code   above    below", indicator_thresholdPercent(level_ui8));
+    }
+    printf("\n");
+    for (cell_ui8 = 0; cell_ui8 < MAX_NUM_OF_CELLS; cell_ui8++)
+    {
+        printf("%5u", cell_ui8 + 1U);
+        for (level_ui8 = 0; level_ui8 < NUM_OF_THRESHOLDS; level_ui8++)
+        {
+            printf("    %9u %.2e %.2e", tolerance_thresholds_aas[cell_ui8][level_ui8].code_ui16,
+                   (float64)tolerance_total_s.above_aaui64[cell_ui8][level_ui8] / boards_f64,
+                   (float64)tolerance_total_s.below_aaui64[cell_ui8][level_ui8] / boards_f64);
+        }
+        printf("\n");
+    }
+}
+
+
+/* ************************************ E O F *************************************************** */
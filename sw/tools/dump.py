@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+dump.py - pulls the statistics and the voltage history off the 328 board.
+
+Negotiates a high baudrate with the firmware (see src/dump/dump.h of
+embedded_328), receives the frames and prints them as text or csv.
+
+usage: dump.py /dev/ttyUSB0 [--baud 1000000] [--csv]
+
+needs pyserial.
+"""
+import argparse
+import struct
+import sys
+import time
+
+import serial
+
+NORMAL_BAUD = 9600
+FAST_BAUDS = {9600: 0, 250000: 1, 500000: 2, 1000000: 3}   # uart_baudType
+
+FRAME_START = 0xA5
+FRAME_STATS = 0x01
+FRAME_HISTORY = 0x02
+FRAME_TRACE = 0x03          # decoded by trace2json.py
+FRAME_END = 0xFF
+
+HISTORY_OFFSET_MV = 2500
+HISTORY_STEP_MV = 10
+HISTORY_LEVELS = ("1s", "1min", "15min")
+
+STATS_FORMAT = "<HHIIHHH"   # stats_RecordType, avr is little endian and packed
+
+
+def crc8_ccitt(data, crc=0):
+    """same as _crc8_ccitt_update() of avr-libc"""
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def negotiate(port, baud):
+    """sends the request at 9600 and follows the device to the new baudrate"""
+    port.baudrate = NORMAL_BAUD
+    port.reset_input_buffer()
+    port.write(b"dump %d\n" % FAST_BAUDS[baud])
+
+    # the status lines of the main loop may come first
+    deadline = time.monotonic() + 3.0
+    while time.monotonic() < deadline:
+        line = port.readline()
+        if line.startswith(b"DUMP"):
+            break
+    else:
+        raise RuntimeError("no answer to the dump request")
+
+    port.baudrate = baud
+    time.sleep(0.01)
+    port.reset_input_buffer()
+    port.write(b"S\n")
+
+
+def read_exact(port, length):
+    data = port.read(length)
+    if len(data) != length:
+        raise RuntimeError("timeout inside a frame")
+    return data
+
+
+def read_frames(port):
+    frames = []
+    while True:
+        byte = read_exact(port, 1)
+        if byte[0] != FRAME_START:
+            continue
+        frame_type, length = read_exact(port, 2)
+        payload = read_exact(port, length)
+        crc = read_exact(port, 1)[0]
+        if crc8_ccitt(bytes([frame_type, length]) + payload) != crc:
+            raise RuntimeError("crc error in frame type 0x%02x" % frame_type)
+        if frame_type == FRAME_END:
+            if payload[0] != len(frames):
+                raise RuntimeError("lost frames: %d of %d" % (len(frames), payload[0]))
+            return frames
+        frames.append((frame_type, payload))
+
+
+def decode_history(payload):
+    """returns the level and its slots oldest first as (min, avg, max) in mV"""
+    level = payload[0]
+    depth = (len(payload) - 3) // 3
+    slots = payload[1:1 + 3 * depth]
+    head, count = payload[1 + 3 * depth], payload[2 + 3 * depth]
+    result = []
+    for i in range(count):
+        index = (head - count + i) % depth
+        result.append(tuple(HISTORY_OFFSET_MV + HISTORY_STEP_MV * v for v in slots[3 * index:3 * index + 3]))
+    return level, result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port")
+    parser.add_argument("--baud", type=int, default=1000000, choices=sorted(FAST_BAUDS))
+    parser.add_argument("--csv", action="store_true", help="history as csv: level,slot,min,avg,max")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, NORMAL_BAUD, timeout=1.0) as port:
+        start = time.monotonic()
+        negotiate(port, args.baud)
+        frames = read_frames(port)
+        elapsed = time.monotonic() - start
+        port.baudrate = NORMAL_BAUD
+
+    for frame_type, payload in frames:
+        if frame_type == FRAME_STATS:
+            (sequence, power_on, runtime, low, session_min, last_min, _) = struct.unpack(STATS_FORMAT, payload)
+            print("# power on: %d, runtime: %d s, below 20%%: %d s, session min: %d mV, last session min: %d mV"
+                  % (power_on, runtime, low, session_min, last_min), file=sys.stderr if args.csv else sys.stdout)
+        elif frame_type == FRAME_HISTORY:
+            level, slots = decode_history(payload)
+            if args.csv:
+                for index, (vmin, vavg, vmax) in enumerate(slots):
+                    print("%d,%d,%d,%d,%d" % (level, index, vmin, vavg, vmax))
+            else:
+                print("level %s, %d slots, oldest first (min/avg/max mV):" % (HISTORY_LEVELS[level], len(slots)))
+                for vmin, vavg, vmax in slots:
+                    print("  %4d %4d %4d" % (vmin, vavg, vmax))
+
+    print("# %d frames in %.2f s at %d baud" % (len(frames), elapsed, args.baud), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
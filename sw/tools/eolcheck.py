@@ -0,0 +1,37 @@
+#!/usr/bin/env python3
+"""
+eolcheck.py - line ends of the tracked files against .gitattributes.
+
+A file marked -text in .gitattributes came with crlf line ends and has to keep
+them on every line, git does not convert it. Every other text file has lf line
+ends only. Binary files are skipped. The line ends are taken from the index, so
+stage the files before the check.
+
+usage: eolcheck.py [path ...]      default: the whole tree
+"""
+import subprocess
+import sys
+
+
+def main():
+    paths = sys.argv[1:]
+    output = subprocess.run(["git", "ls-files", "--eol", "--"] + paths, check=True, capture_output=True,
+                            text=True).stdout
+    errors = []
+    for line in output.splitlines():
+        fields, path = line.split("\t", 1)
+        index, _, attributes = (fields.split() + [""])[:3]
+        if index in ("i/-text", "i/none", "i/"):
+            continue
+        if "-text" in attributes:
+            if index != "i/crlf":
+                errors.append("%s: marked -text for crlf, has %s" % (path, index[2:]))
+        elif index != "i/lf":
+            errors.append("%s: has %s, only files marked -text keep crlf" % (path, index[2:]))
+    for error in errors:
+        print("error: " + error, file=sys.stderr)
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
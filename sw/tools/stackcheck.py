@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""
+stackcheck.py - worst case stack depth of the firmware from the call graph of gcc.
+
+Reads the .ci files that gcc 10 or later writes with -fcallgraph-info=su, one
+per translation unit, and walks the calls from main() and from every interrupt
+vector. The depth of a path is the sum of the frames plus the return address
+of every call. The interrupts are taken as if each one could interrupt main()
+and every other one at its deepest point, so the bound is main() plus all
+vectors, which covers every nesting.
+
+usage: stackcheck.py --sram 2048 [--elf main.elf] [--static 0] [--indirect REGEX] src/*.ci
+
+the check fails (exit code 1) if the bound does not fit into the sram that
+.data and .bss leave free, if a function has a dynamic frame, if the graph is
+recursive or if an indirect call has no --indirect targets. the static size is
+taken from the sections of --elf with avr-size, or given with --static.
+"""
+import argparse
+import re
+import subprocess
+import sys
+
+NODE = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+FRAME = re.compile(r'\\n(\d+) bytes \(([a-z,]+)\)')
+
+INDIRECT = "__indirect_call"
+STATIC_SECTIONS = (".data", ".bss", ".noinit")
+
+
+class Graph:
+    """the frames and calls of all files, a static function is found in its own file first"""
+
+    def __init__(self):
+        self.frames = {}    # (file, function) -> bytes
+        self.dynamic = []   # (file, function) with a frame that is not static
+        self.calls = {}     # (file, function) -> [callee name]
+        self.files = {}     # function -> [file], where it is defined
+
+    def read(self, path):
+        with open(path) as ci:
+            for line in ci:
+                node = NODE.search(line)
+                if node:
+                    frame = FRAME.search(node.group(2))
+                    if frame:
+                        key = (path, node.group(1))
+                        self.frames[key] = int(frame.group(1))
+                        self.files.setdefault(node.group(1), []).append(path)
+                        if frame.group(2) != "static":
+                            self.dynamic.append(key)
+                    continue
+                edge = EDGE.search(line)
+                if edge:
+                    self.calls.setdefault((path, edge.group(1)), []).append(edge.group(2))
+
+    def resolve(self, path, name):
+        """the definitions a call from path reaches, [] for a function of the libraries"""
+        if (path, name) in self.frames:
+            return [(path, name)]
+        return [(other, name) for other in self.files.get(name, [])]
+
+
+class Walker:
+    def __init__(self, graph, call_bytes, extern_bytes, indirect):
+        self.graph = graph
+        self.call_bytes = call_bytes
+        self.extern_bytes = extern_bytes
+        self.indirect = indirect
+        self.depths = {}
+        self.externs = set()
+        self.errors = []
+
+    def depth(self, key, path=()):
+        """deepest stack of key and everything it calls, including its own frame"""
+        if key in self.depths:
+            return self.depths[key]
+        if key in path:
+            self.errors.append("recursion: " + " -> ".join(name for _, name in path + (key,)))
+            return 0
+        deepest = 0
+        for callee in self.graph.calls.get(key, []):
+            if callee == INDIRECT:
+                if not self.indirect:
+                    self.errors.append("indirect call in %s, give its targets with --indirect" % key[1])
+                    continue
+                targets = [target for target in self.indirect if target not in path + (key,)]
+            else:
+                targets = self.graph.resolve(key[0], callee)
+                if not targets:
+                    self.externs.add(callee)
+                    deepest = max(deepest, self.call_bytes + self.extern_bytes)
+                    continue
+            for target in targets:
+                deepest = max(deepest, self.call_bytes + self.depth(target, path + (key,)))
+        self.depths[key] = self.graph.frames[key] + deepest
+        return self.depths[key]
+
+
+def static_bytes(elf, size_tool):
+    """.data, .bss and .noinit of the elf, from the sysv output of avr-size"""
+    output = subprocess.run([size_tool, "-A", elf], check=True, capture_output=True, text=True).stdout
+    total = 0
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0] in STATIC_SECTIONS:
+            total += int(fields[1])
+    return total
+
+
+def main():
+    parser = argparse.ArgumentParser(description="worst case stack depth from gcc -fcallgraph-info=su")
+    parser.add_argument("ci", nargs="+", help=".ci files of all translation units")
+    parser.add_argument("--sram", type=int, required=True, help="bytes of sram of the mcu")
+    parser.add_argument("--elf", help="the firmware, for the size of .data and .bss")
+    parser.add_argument("--size-tool", default="avr-size")
+    parser.add_argument("--static", type=int, help="size of .data and .bss instead of --elf")
+    parser.add_argument("--call-bytes", type=int, default=2, help="return address of a call or an interrupt")
+    parser.add_argument("--extern-bytes", type=int, default=8, help="allowance for a call into the libraries")
+    parser.add_argument("--indirect", help="regex of the functions an indirect call can reach")
+    parser.add_argument("--isr", default=r"__vector_\d+", help="regex of the interrupt vectors")
+    args = parser.parse_args()
+
+    graph = Graph()
+    for path in args.ci:
+        graph.read(path)
+
+    indirect = []
+    if args.indirect:
+        indirect = [key for key in graph.frames if re.fullmatch(args.indirect, key[1])]
+    walker = Walker(graph, args.call_bytes, args.extern_bytes, indirect)
+
+    mains = graph.resolve("", "main")
+    if not mains:
+        print("no main() in the call graph", file=sys.stderr)
+        return 1
+    main_depth = max(walker.depth(key) for key in mains)
+    vectors = sorted(key for key in graph.frames if re.fullmatch(args.isr, key[1]))
+    bound = main_depth
+    print("%-24s %5u bytes" % ("main", main_depth))
+    for key in vectors:
+        depth = args.call_bytes + walker.depth(key)
+        bound += depth
+        print("%-24s %5u bytes" % (key[1], depth))
+
+    if args.static is not None:
+        static = args.static
+    elif args.elf:
+        static = static_bytes(args.elf, args.size_tool)
+    else:
+        parser.error("give --elf or --static")
+    free = args.sram - static
+    print("%-24s %5u bytes, %u free after %u static" % ("bound", bound, free, static))
+    if walker.externs:
+        print("library calls, %u bytes each: %s" % (args.extern_bytes, " ".join(sorted(walker.externs))))
+
+    for key in graph.dynamic:
+        walker.errors.append("dynamic frame in %s" % key[1])
+    if bound > free:
+        walker.errors.append("the bound of %u bytes does not fit into %u free bytes" % (bound, free))
+    for error in walker.errors:
+        print("error: " + error, file=sys.stderr)
+    return 1 if walker.errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""
+trace2json.py - pulls the event trace off the 328 board.
+
+Runs the dump of dump.py, takes the trace frame (see src/trace/trace.h of
+embedded_328) and writes the events oldest first, either as a chrome trace
+for chrome://tracing or ui.perfetto.dev, or as a text timeline.
+
+usage: trace2json.py /dev/ttyUSB0 [--baud 1000000] [--timeline] [-o trace.json]
+
+select what is recorded before with the line "trace <mask>" at 9600 baud,
+the bits are GROUPS below. needs pyserial.
+"""
+import argparse
+import json
+import struct
+import sys
+
+import serial
+
+from dump import FAST_BAUDS, FRAME_TRACE, NORMAL_BAUD, negotiate, read_frames
+
+GROUPS = {0x01: "adc", 0x02: "led", 0x04: "uart", 0x08: "scheduler", 0x10: "isr"}
+
+# trace_EventType: name, chrome phase
+EVENTS = {
+    0x01: ("adc", "B"),
+    0x02: ("adc", "E"),
+    0x11: ("led", "i"),
+    0x21: ("uart tx", "i"),
+    0x22: ("uart line", "i"),
+    0x31: ("loop", "i"),
+    0x32: ("command", "i"),
+    0x41: ("isr", "B"),
+    0x42: ("isr", "E"),
+}
+ISRS = ("USART_RX", "USART_UDRE", "TWI", "ADC")    # trace_IsrType
+
+ENTRY_FORMAT = "<BHH"       # trace_EntryType, packed
+TICK_US = 1000              # TIMER_TICK_MS
+STAMP_PERIOD_US = 256 * TICK_US
+
+
+def decode_trace(payload):
+    """returns the entries oldest first as (event, stamp, payload)"""
+    size = struct.calcsize(ENTRY_FORMAT)
+    depth = (len(payload) - 2) // size
+    head, count = payload[depth * size], payload[depth * size + 1]
+    entries = []
+    for i in range(count):
+        index = (head - count + i) % depth
+        entries.append(struct.unpack_from(ENTRY_FORMAT, payload, index * size))
+    return entries
+
+
+def unwrap(entries, count_us):
+    """stamps to microseconds since the oldest entry, gaps of 256ms and more are lost"""
+    result = []
+    last = None
+    offset = 0
+    for event, stamp, value in entries:
+        us = (stamp >> 8) * TICK_US + (stamp & 0xFF) * count_us
+        if last is not None and us + offset < last:
+            offset += STAMP_PERIOD_US
+        last = us + offset
+        result.append((last, event, value))
+    if result:
+        first = result[0][0]
+        result = [(us - first, event, value) for us, event, value in result]
+    return result
+
+
+def describe(event, value):
+    name, phase = EVENTS.get(event, ("0x%02x" % event, "i"))
+    if name == "isr":
+        name = ISRS[value] if value < len(ISRS) else "isr %d" % value
+    return name, phase
+
+
+def to_chrome(events):
+    trace = []
+    for us, event, value in events:
+        name, phase = describe(event, value)
+        record = {"name": name, "ph": phase, "ts": us, "pid": 0,
+                  "tid": GROUPS.get(1 << (event >> 4), "other"), "args": {"value": value}}
+        if phase == "i":
+            record["s"] = "t"
+        trace.append(record)
+    return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def to_timeline(events, out):
+    for us, event, value in events:
+        name, phase = describe(event, value)
+        mark = {"B": ">", "E": "<"}.get(phase, " ")
+        print("%10.3f ms %s %-10s %5d  0x%04x" % (us / 1000.0, mark, name, value, value), file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port")
+    parser.add_argument("--baud", type=int, default=1000000, choices=sorted(FAST_BAUDS))
+    parser.add_argument("--f-cpu", type=int, default=16000000, help="F_CPU of the board")
+    parser.add_argument("--timeline", action="store_true", help="text instead of a chrome trace")
+    parser.add_argument("-o", "--output", help="file instead of stdout")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, NORMAL_BAUD, timeout=1.0) as port:
+        negotiate(port, args.baud)
+        frames = read_frames(port)
+        port.baudrate = NORMAL_BAUD
+
+    payloads = [payload for frame_type, payload in frames if frame_type == FRAME_TRACE]
+    if not payloads:
+        sys.exit("no trace frame, firmware built with TRACE_MODE STD_OFF?")
+
+    # timer0 counts at F_CPU / TIMER_PRESCALER
+    events = unwrap(decode_trace(payloads[0]), 64 * 1000000.0 / args.f_cpu)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    if args.timeline:
+        to_timeline(events, out)
+    else:
+        json.dump(to_chrome(events), out, indent=1)
+        out.write("\n")
+    if args.output:
+        out.close()
+    print("# %d events over %.1f ms" % (len(events), events[-1][0] / 1000.0 if events else 0.0), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()